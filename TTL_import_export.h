@@ -22,6 +22,7 @@
 #include TTL_IMPORT_EXPORT_INCLUDE_H
 
 #define TTL_MAX(X, Y) (((X) > (Y)) ? (X) : (Y))
+#define TTL_MIN(X, Y) (((X) < (Y)) ? (X) : (Y))
 
 /**
  * @brief Fill block of local memory
@@ -37,104 +38,972 @@
  * @return ptr is to the output is returned.
  */
 static inline TTL_local(void *) TTL_local_memset(TTL_local(void *) const ptr, char value, size_t num) {
-    TTL_local(char *) const dst = (TTL_local(char *))ptr;
-
-    for (size_t byte = 0; byte < num; byte++)
-        dst[byte] = value;
+    if (num != 0) __TTL_local_fill(ptr, value, num);
 
     return ptr;
 }
 
+/**
+ * @brief Fill num bytes of local memory with elements of value
+ *
+ * Zero, and any value of single byte elements, is filled with TTL_local_memset.
+ *
+ * @param ptr Pointer to the first element to fill.
+ * @param value The value of each element, converted to an element of elem_size bytes.
+ * @param elem_size The size of each element in bytes.
+ * @param num Number of bytes to be set, a multiple of elem_size.
+ */
+static inline void __TTL_local_fill_elements(TTL_local(void *) const ptr, const long value, const size_t elem_size,
+                                             const size_t num) {
+    if ((value == 0) || (elem_size == 1)) {
+        TTL_local_memset(ptr, (char)value, num);
+        return;
+    }
+
+    if (elem_size == sizeof(short)) {
+        for (size_t i = 0; i < (num / sizeof(short)); i++) ((TTL_local(short *))ptr)[i] = (short)value;
+    } else if (elem_size == sizeof(int)) {
+        for (size_t i = 0; i < (num / sizeof(int)); i++) ((TTL_local(int *))ptr)[i] = (int)value;
+    } else if (elem_size == sizeof(long)) {
+        for (size_t i = 0; i < (num / sizeof(long)); i++) ((TTL_local(long *))ptr)[i] = value;
+    } else {
+        // Other sizes take the bytes of value least significant first.
+        for (size_t i = 0; i < num; i++) {
+            const size_t byte = i % elem_size;
+            ((TTL_local(char *))ptr)[i] = byte < sizeof(long) ? (char)(value >> (byte * 8)) : 0;
+        }
+    }
+}
+
+/**
+ * @brief Fill the elements of an internal tensor outside of a block with elements of value.
+ *
+ * Only the space around the lines of the block is filled. The space between the end of one line
+ * of the block and the start of the next is contiguous, including from the last line of one plane
+ * to the first of the next, so each is filled by a single fill, as are the lines and planes before
+ * and after the block. Any space between the end of a line and the row spacing is filled too.
+ *
+ * @param tensor The internal tensor to fill.
+ * @param value The value of each element filled, @see TTL_boundary_t
+ * @param begin The first element of the block, which is not filled.
+ * @param end One past the last element of the block in each dimension.
+ */
+static inline void TTL_fill_void_space(const TTL_int_tensor_t tensor, const long value, const TTL_offset_t begin,
+                                       const TTL_offset_t end) {
+    const size_t elem_size = tensor.elem_size;
+    const size_t line_bytes = tensor.layout.row_spacing * elem_size;
+    const size_t plane_bytes = tensor.layout.plane_spacing * elem_size;
+    const size_t tensor_bytes = ((tensor.shape.depth - 1) * plane_bytes) + (tensor.shape.height * line_bytes);
+    const size_t block_begin_bytes = begin.x * elem_size;
+    const size_t block_end_bytes = end.x * elem_size;
+    TTL_local(char *) const base = (TTL_local(char *))tensor.base;
+    size_t fill_from = 0;
+
+    // Nothing lies outside of the block.
+    if ((begin.x == 0) && (begin.y == 0) && (begin.z == 0) &&
+        (end.x == (TTL_offset_dim_t)tensor.layout.row_spacing) && (end.y == (TTL_offset_dim_t)tensor.shape.height) &&
+        (end.z == (TTL_offset_dim_t)tensor.shape.depth) &&
+        ((tensor.shape.depth == 1) || (plane_bytes == (tensor.shape.height * line_bytes))))
+        return;
+
+    for (TTL_offset_dim_t plane = begin.z; plane < end.z; plane++) {
+        for (TTL_offset_dim_t line = begin.y; line < end.y; line++) {
+            const size_t line_from = (plane * plane_bytes) + (line * line_bytes);
+            const size_t copy_from = line_from + block_begin_bytes;
+
+            if (copy_from > fill_from)
+                __TTL_local_fill_elements(base + fill_from, value, elem_size, copy_from - fill_from);
+            fill_from = line_from + block_end_bytes;
+        }
+    }
+
+    if (tensor_bytes > fill_from)
+        __TTL_local_fill_elements(base + fill_from, value, elem_size, tensor_bytes - fill_from);
+}
+
 /**
  * @brief Clear any unpopulated space in the target area.
  *
- * @param dst
- * @param x_offset
- * @param y_offset
- * @param num_bytes_per_element
- * @param num_elements_per_line
- * @param dst_total_line_length
- * @param num_lines
- * @param total_lines
- * @param num_planes
+ * The planes are taken to follow one another, so a plane is total_lines lines.
+ *
+ * @see TTL_fill_void_space, which this calls with a value of zero.
  */
 static inline void TTL_clear_void_space(TTL_local(void *) const dst, const size_t x_offset, const size_t y_offset,
                                         size_t num_bytes_per_element, size_t num_elements_per_line,
                                         size_t dst_total_line_length, size_t num_lines, size_t total_lines,
                                         size_t num_planes) {
-    TTL_local(char *) dst_ptr = (TTL_local(char *))dst;
-    unsigned int left_trim_bytes = x_offset * num_bytes_per_element;
-    unsigned int right_trim_bytes = (dst_total_line_length - num_elements_per_line) * num_bytes_per_element;
-
-    for (size_t plane = 0; plane < num_planes; plane++) {
-        for (size_t line = 0; line < total_lines; line++) {
-            if ((line < y_offset) || (line >= num_lines)) {
-                TTL_local_memset(dst_ptr, 0, dst_total_line_length * num_bytes_per_element);
-            } else {
-                // Clear anything not being copied to zero - will make the 'clear value'
-                // definable at some level.
-                TTL_local_memset(dst_ptr, 0, left_trim_bytes);
-                TTL_local_memset(dst_ptr + (num_elements_per_line * num_bytes_per_element), 0, right_trim_bytes);
-            }
-            dst_ptr += dst_total_line_length * num_bytes_per_element;
+    const TTL_int_tensor_t tensor =
+        TTL_create_int_tensor(dst,
+                              TTL_create_shape(dst_total_line_length, total_lines, num_planes),
+                              TTL_create_layout(dst_total_line_length, dst_total_line_length * total_lines),
+                              num_bytes_per_element);
+
+    TTL_fill_void_space(tensor,
+                        0,
+                        TTL_create_offset(x_offset, y_offset),
+                        TTL_create_offset(num_elements_per_line, num_lines, num_planes));
+}
+
+/**
+ * @brief Return true if TTL_import_pre_fill will write to the internal sub tensor.
+ *
+ * This is the case when part of the sub tensor lies outside of its origin tensor.
+ *
+ * The fill takes place when the import is issued rather than when it is performed,
+ * so a transfer still reading from the same internal buffer must be waited for
+ * first.
+ *
+ * @param internal_sub_tensor The internal sub tensor that is to be imported to.
+ */
+static inline bool TTL_import_pre_fill_required(const TTL_int_sub_tensor_t internal_sub_tensor) {
+    return (internal_sub_tensor.origin.sub_offset.x < 0) || (internal_sub_tensor.origin.sub_offset.y < 0) ||
+           (internal_sub_tensor.origin.sub_offset.z < 0) ||
+           ((internal_sub_tensor.origin.sub_offset.x + internal_sub_tensor.tensor.shape.width) >
+            internal_sub_tensor.origin.shape.width) ||
+           ((internal_sub_tensor.origin.sub_offset.y + internal_sub_tensor.tensor.shape.height) >
+            internal_sub_tensor.origin.shape.height) ||
+           ((internal_sub_tensor.origin.sub_offset.z + internal_sub_tensor.tensor.shape.depth) >
+            internal_sub_tensor.origin.shape.depth);
+}
+
+/**
+ * @def TTL_ZERO_COPY_IMPORT
+ *
+ * @brief Import tiles that need no padding by referencing the external tensor rather than copying it.
+ *
+ * Only has an effect where internal and external memory are the same address space, for
+ * example the C target. TTL_import_sub_tensor then issues no transfer for such tiles and
+ * TTL_imported_sub_tensor, which the pipelining schemes use for the tensors they return,
+ * describes the tile in place in the external tensor using the external layout. Tiles
+ * that need padding are still copied. Imported tensors must not be written by the kernel.
+ */
+#if defined(TTL_ZERO_COPY_IMPORT) && defined(__TTL_SHARED_ADDRESS_SPACE)
+#define __TTL_ZERO_COPY_IMPORT_ENABLED
+#endif
+
+/**
+ * @def __TTL_ext_addressable
+ *
+ * @brief True if external memory at address can be read in place.
+ *
+ * A target may define this, for example when some external memory is not ordinary memory.
+ */
+#ifndef __TTL_ext_addressable
+#define __TTL_ext_addressable(address) ((void)(address), true)
+#endif
+
+/**
+ * @brief Return true if TTL_import_sub_tensor will reference rather than copy the external tensor
+ *
+ * @param internal_sub_tensor The sub tensor being imported to.
+ * @param const_external_tensor The external tensor being imported from.
+ *
+ * @see TTL_ZERO_COPY_IMPORT
+ */
+static inline bool TTL_import_zero_copy(const TTL_int_sub_tensor_t internal_sub_tensor,
+                                        const TTL_const_ext_tensor_t const_external_tensor) {
+#ifdef __TTL_ZERO_COPY_IMPORT_ENABLED
+    return (TTL_import_pre_fill_required(internal_sub_tensor) == false) &&
+           __TTL_ext_addressable(const_external_tensor.base);
+#else
+    (void)internal_sub_tensor;
+    (void)const_external_tensor;
+    return false;
+#endif
+}
+
+/**
+ * @def __TTL_prefetch_3D
+ *
+ * @brief Hint that a 3D block of external memory will be imported soon.
+ *
+ * A target may define this to start bringing the block closer, taking the parameters of
+ * async_work_group_copy_3D3D for the source. Where it is not defined prefetching does nothing.
+ */
+
+/**
+ * @brief Hint that a tile of an external tensor will be imported soon.
+ *
+ * Only the part of the tile inside the tensor is prefetched, so tiles including augmentation
+ * may be passed.
+ *
+ * @param const_external_tensor The external tensor the tile will be imported from.
+ * @param tile The tile that will be imported.
+ */
+static inline void TTL_prefetch_tile(const TTL_const_ext_tensor_t const_external_tensor, const TTL_tile_t tile) {
+#ifdef __TTL_prefetch_3D
+    const TTL_offset_t begin = TTL_create_offset(
+        TTL_MAX(tile.offset.x, 0), TTL_MAX(tile.offset.y, 0), TTL_MAX(tile.offset.z, 0));
+    const TTL_offset_t end =
+        TTL_create_offset(TTL_MIN(tile.offset.x + (TTL_offset_dim_t)tile.shape.width,
+                                  (TTL_offset_dim_t)const_external_tensor.shape.width),
+                          TTL_MIN(tile.offset.y + (TTL_offset_dim_t)tile.shape.height,
+                                  (TTL_offset_dim_t)const_external_tensor.shape.height),
+                          TTL_MIN(tile.offset.z + (TTL_offset_dim_t)tile.shape.depth,
+                                  (TTL_offset_dim_t)const_external_tensor.shape.depth));
+
+    if ((TTL_tile_empty(tile) == false) && (end.x > begin.x) && (end.y > begin.y) && (end.z > begin.z)) {
+        __TTL_prefetch_3D((TTL_global(const char *))const_external_tensor.base +
+                              (TTL_linearize(begin, const_external_tensor.layout) * const_external_tensor.elem_size),
+                          const_external_tensor.elem_size,
+                          end.x - begin.x,
+                          end.y - begin.y,
+                          end.z - begin.z,
+                          const_external_tensor.layout.row_spacing,
+                          const_external_tensor.layout.plane_spacing);
+    }
+#else
+    (void)const_external_tensor;
+    (void)tile;
+#endif
+}
+
+/**
+ * @brief Prefetch the tile expected to be imported after next_tile.
+ *
+ * The pipelining schemes only know the tile being imported, so the one after it is assumed
+ * to follow on by the same step as next_tile did from prev_tile. Where that is wrong, for
+ * example at the end of a row of tiles, the prefetch is wasted or clipped away.
+ *
+ * @param const_external_tensor The external tensor the tiles are imported from.
+ * @param prev_tile The tile imported before next_tile.
+ * @param next_tile The tile being imported.
+ */
+static inline void TTL_prefetch_tile_after(const TTL_const_ext_tensor_t const_external_tensor,
+                                           const TTL_tile_t prev_tile, const TTL_tile_t next_tile) {
+    if (TTL_tile_empty(prev_tile) || TTL_tile_empty(next_tile)) return;
+
+    TTL_tile_t tile_after = next_tile;
+
+    tile_after.offset.x += next_tile.offset.x - prev_tile.offset.x;
+    tile_after.offset.y += next_tile.offset.y - prev_tile.offset.y;
+    tile_after.offset.z += next_tile.offset.z - prev_tile.offset.z;
+
+    TTL_prefetch_tile(const_external_tensor, tile_after);
+}
+
+/**
+ * @brief The padding last written to an internal buffer by TTL_import_pre_fill_cached
+ *
+ * The elements of the tile from begin up to end were imported, everything else in the tile,
+ * including any space between the end of a line and the row spacing, was filled with value.
+ */
+typedef struct {
+    TTL_shape_t shape;    ///< The shape of the tile, empty if the contents of the buffer are unknown
+    TTL_layout_t layout;  ///< The layout of the tile
+    TTL_dim_t elem_size;  ///< The size of the elements of the tile
+    TTL_offset_t begin;   ///< The first element of the tile that was imported
+    TTL_offset_t end;     ///< One past the last element of the tile that was imported
+    long value;           ///< The value of the elements that were not imported
+} TTL_padding_cache_t;
+
+/**
+ * @brief Create a TTL_padding_cache_t for a buffer whose contents are unknown
+ */
+static inline TTL_padding_cache_t TTL_create_empty_padding_cache(__TTL_NO_PARAMETERS) {
+    TTL_padding_cache_t result;
+
+    result.shape = TTL_create_shape(0);
+    result.layout = TTL_create_layout();
+    result.elem_size = 0;
+    result.begin = TTL_create_offset();
+    result.end = TTL_create_offset();
+    result.value = 0;
+
+    return result;
+}
+
+/**
+ * @brief Return true if the padding of a tile importing from begin to end already holds value.
+ *
+ * That is the case if the same tile was last imported to the buffer with padding of the same value
+ * that covered at least the same elements, so the imported elements are a superset of those
+ * imported before.
+ */
+static inline bool __TTL_padding_cached(const TTL_padding_cache_t *const padding_cache, const TTL_int_tensor_t tensor,
+                                        const TTL_offset_t begin, const TTL_offset_t end, const long value) {
+    return (padding_cache != NULL) && (padding_cache->value == value) &&
+           (padding_cache->shape.width == tensor.shape.width) &&
+           (padding_cache->shape.height == tensor.shape.height) && (padding_cache->shape.depth == tensor.shape.depth) &&
+           (padding_cache->layout.row_spacing == tensor.layout.row_spacing) &&
+           (padding_cache->layout.plane_spacing == tensor.layout.plane_spacing) &&
+           (padding_cache->elem_size == tensor.elem_size) && (begin.x <= padding_cache->begin.x) &&
+           (begin.y <= padding_cache->begin.y) && (begin.z <= padding_cache->begin.z) &&
+           (end.x >= padding_cache->end.x) && (end.y >= padding_cache->end.y) && (end.z >= padding_cache->end.z);
+}
+
+/**
+ * @brief Find the part of a sub tensor that lies inside of its origin tensor
+ *
+ * @param shape The shape of the sub tensor.
+ * @param origin_shape The shape of the tensor the sub tensor is part of.
+ * @param sub_offset The offset of the sub tensor in the origin tensor, which may be negative.
+ * @param begin Returns the first element of the sub tensor inside the origin tensor.
+ * @param end Returns the element after the last inside the origin tensor, which is begin where
+ * the sub tensor lies wholly outside.
+ */
+static inline void __TTL_sub_tensor_inside(const TTL_shape_t shape, const TTL_shape_t origin_shape,
+                                           const TTL_offset_t sub_offset, TTL_offset_t *const begin,
+                                           TTL_offset_t *const end) {
+    *begin = TTL_create_offset(TTL_MAX(-sub_offset.x, 0), TTL_MAX(-sub_offset.y, 0), TTL_MAX(-sub_offset.z, 0));
+    *end = TTL_create_offset(
+        TTL_MAX(TTL_MIN((TTL_offset_dim_t)origin_shape.width - sub_offset.x, (TTL_offset_dim_t)shape.width), begin->x),
+        TTL_MAX(TTL_MIN((TTL_offset_dim_t)origin_shape.height - sub_offset.y, (TTL_offset_dim_t)shape.height),
+                begin->y),
+        TTL_MAX(TTL_MIN((TTL_offset_dim_t)origin_shape.depth - sub_offset.z, (TTL_offset_dim_t)shape.depth),
+                begin->z));
+}
+
+/**
+ * @brief Prepare the import of an external tensor to an internal sub tensor, filling the parts
+ * of the sub tensor outside of the external tensor.
+ *
+ * As TTL_import_pre_fill, but the padding is only filled if padding_cache shows that it does not
+ * already hold the boundary's value, and padding_cache is then updated. One cache is kept for each
+ * internal buffer, which presumes that nothing but the imports given the cache writes to the
+ * padding of the buffer. The padding of other boundaries depends on where the tile is, so is
+ * never cached.
+ *
+ * @param padding_cache The padding last written to the internal buffer, or NULL if it is not known.
+ */
+static inline TTL_shape_t TTL_import_pre_fill_cached(const TTL_int_sub_tensor_t internal_sub_tensor,
+                                                     const TTL_const_ext_tensor_t const_external_tensor,
+                                                     TTL_local(void *) *const dst_address,
+                                                     TTL_global(void *) *const src_address,
+                                                     TTL_padding_cache_t *const padding_cache) {
+    TTL_offset_t begin;
+    TTL_offset_t end;
+
+    __TTL_sub_tensor_inside(internal_sub_tensor.tensor.shape,
+                            internal_sub_tensor.origin.shape,
+                            internal_sub_tensor.origin.sub_offset,
+                            &begin,
+                            &end);
+
+    // A sub tensor wholly outside of its origin tensor imports nothing and is all padding.
+    if ((end.x <= begin.x) || (end.y <= begin.y) || (end.z <= begin.z)) {
+        begin = TTL_create_offset();
+        end = TTL_create_offset();
+    }
+
+    *dst_address = (TTL_local(char *))internal_sub_tensor.tensor.base +
+                   (TTL_linearize(begin, internal_sub_tensor.tensor.layout) * internal_sub_tensor.tensor.elem_size);
+    *src_address = (TTL_global(char *))const_external_tensor.base +
+                   (TTL_linearize(begin, const_external_tensor.layout) * const_external_tensor.elem_size);
+
+    const TTL_boundary_t boundary = internal_sub_tensor.origin.boundary;
+
+    // Interior tiles have nothing to fill, and other boundaries are imported by __TTL_import_boundary.
+    if ((boundary.mode == TTL_BOUNDARY_CONSTANT) && TTL_import_pre_fill_required(internal_sub_tensor) &&
+        (__TTL_padding_cached(padding_cache, internal_sub_tensor.tensor, begin, end, boundary.value) == false)) {
+        TTL_fill_void_space(internal_sub_tensor.tensor, boundary.value, begin, end);
+    }
+
+    if (padding_cache != NULL) {
+        if (boundary.mode == TTL_BOUNDARY_CONSTANT) {
+            padding_cache->shape = internal_sub_tensor.tensor.shape;
+            padding_cache->layout = internal_sub_tensor.tensor.layout;
+            padding_cache->elem_size = internal_sub_tensor.tensor.elem_size;
+            padding_cache->begin = begin;
+            padding_cache->end = end;
+            padding_cache->value = boundary.value;
+        } else {
+            *padding_cache = TTL_create_empty_padding_cache();
         }
     }
+
+    return TTL_create_shape(end.x - begin.x, end.y - begin.y, end.z - begin.z);
 }
 
+/**
+ * @brief Prepare the import of an external tensor to an internal sub tensor, filling the parts
+ * of the sub tensor outside of the external tensor.
+ *
+ * A TTL_BOUNDARY_CONSTANT boundary is filled before returning. The parts of other boundaries
+ * are imported from the external tensor by __TTL_import_boundary.
+ *
+ * @param internal_sub_tensor The sub tensor being imported to.
+ * @param const_external_tensor The external tensor being imported from.
+ * @param dst_address Returns the internal address the first imported element is written to.
+ * @param src_address Returns the external address the first imported element is read from.
+ *
+ * @return The shape of the part of the sub tensor that is imported.
+ */
 static inline TTL_shape_t TTL_import_pre_fill(const TTL_int_sub_tensor_t internal_sub_tensor,
                                               const TTL_const_ext_tensor_t const_external_tensor,
                                               TTL_local(void *) *const dst_address,
                                               TTL_global(void *) *const src_address) {
-    size_t x_offset;
-    size_t x_cut;
-    size_t y_offset;
-    size_t y_cut;
-    size_t z_offset;
-    size_t z_cut;
-
-    x_offset = TTL_MAX(-internal_sub_tensor.origin.sub_offset.x, 0);
-    x_cut = (internal_sub_tensor.origin.sub_offset.x + internal_sub_tensor.tensor.shape.width) >
-                    internal_sub_tensor.origin.shape.width
-                ? (internal_sub_tensor.origin.sub_offset.x + internal_sub_tensor.tensor.shape.width) -
-                      internal_sub_tensor.origin.shape.width
-                : 0;
-
-    y_offset = TTL_MAX(-internal_sub_tensor.origin.sub_offset.y, 0);
-    y_cut = (internal_sub_tensor.origin.sub_offset.y + internal_sub_tensor.tensor.shape.height) >
-                    internal_sub_tensor.origin.shape.height
-                ? (internal_sub_tensor.origin.sub_offset.y + internal_sub_tensor.tensor.shape.height) -
-                      internal_sub_tensor.origin.shape.height
-                : 0;
-
-    z_offset = 0;  // TTL_MAX(-internal_sub_tensor.origin.sub_offset.z, 0);
-    z_cut = 0;     // TTL_MAX((internal_sub_tensor.origin.sub_offset.z + internal_sub_tensor.tensor.shape.depth) -
-                   //     1 /* Internal_sub_tensor.origin.shape.depth */
-                   // 0);
+    return TTL_import_pre_fill_cached(internal_sub_tensor, const_external_tensor, dst_address, src_address, NULL);
+}
 
-    *dst_address = (TTL_local(char *))internal_sub_tensor.tensor.base +
-                   (x_offset * internal_sub_tensor.tensor.elem_size) +
-                   (y_offset * internal_sub_tensor.tensor.layout.row_spacing * internal_sub_tensor.tensor.elem_size) +
-                   (z_offset * internal_sub_tensor.tensor.layout.plane_spacing * internal_sub_tensor.tensor.elem_size);
+/**
+ * @brief Begin the import of a block of the boundary of an internal sub tensor
+ *
+ * A block of shape elements is imported to position in the sub tensor from ext_position in its
+ * origin tensor.
+ */
+static inline void __TTL_TRACE_FN(__TTL_import_boundary_block, const TTL_int_sub_tensor_t internal_sub_tensor,
+                                  const TTL_const_ext_tensor_t const_external_tensor,
+                                  const TTL_conversion_t conversion, TTL_event_t *const event,
+                                  const TTL_offset_t position, const TTL_offset_t ext_position,
+                                  const TTL_shape_t shape) {
+    TTL_local(void *) const to_base =
+        (TTL_local(char *))internal_sub_tensor.tensor.base +
+        (TTL_linearize(position, internal_sub_tensor.tensor.layout) * internal_sub_tensor.tensor.elem_size);
+    const TTL_int_tensor_t to =
+        TTL_create_int_tensor(to_base, shape, internal_sub_tensor.tensor.layout, internal_sub_tensor.tensor.elem_size);
+
+    // The base of the external tensor is the element of the origin tensor at the sub tensor's offset.
+    const TTL_const_ext_tensor_t from =
+        TTL_create_const_ext_tensor(const_external_tensor.base,
+                                    shape,
+                                    const_external_tensor.layout,
+                                    TTL_create_offset(ext_position.x - internal_sub_tensor.origin.sub_offset.x,
+                                                      ext_position.y - internal_sub_tensor.origin.sub_offset.y,
+                                                      ext_position.z - internal_sub_tensor.origin.sub_offset.z),
+                                    const_external_tensor.elem_size);
+
+    TTL_import_convert_base(to, from, conversion, event __TTL_TRACE_LINE);
+}
+
+/**
+ * @brief Begin the import of the parts of an internal sub tensor outside of its origin tensor
+ *
+ * TTL_BOUNDARY_REPLICATE and TTL_BOUNDARY_MIRROR boundaries repeat elements of the origin tensor,
+ * so rather than being filled by TTL_import_pre_fill they are imported from it along with the rest
+ * of the tile, against the same event. Each plane in front of or behind the tensor is imported from
+ * the plane it repeats, in the same way as the planes inside the tensor are imported together. Of
+ * those, each line above or below the tensor is imported from the line it repeats, each column to
+ * the left or right from the column it repeats, and each corner element on its own. Other
+ * boundaries import nothing.
+ *
+ * @param internal_sub_tensor The sub tensor being imported to.
+ * @param const_external_tensor The external tensor being imported from, whose base is the element at
+ * the sub tensor's offset.
+ * @param conversion The conversion applied to each element, @see TTL_import_convert_base
+ * @param event A pointer to the event which describes the transfer.
+ */
+static inline void __TTL_TRACE_FN(__TTL_import_boundary, const TTL_int_sub_tensor_t internal_sub_tensor,
+                                  const TTL_const_ext_tensor_t const_external_tensor,
+                                  const TTL_conversion_t conversion, TTL_event_t *const event) {
+    const TTL_boundary_t boundary = internal_sub_tensor.origin.boundary;
+
+    if ((boundary.mode == TTL_BOUNDARY_CONSTANT) || (TTL_import_pre_fill_required(internal_sub_tensor) == false))
+        return;
+
+    const TTL_shape_t shape = internal_sub_tensor.tensor.shape;
+    const TTL_shape_t origin_shape = internal_sub_tensor.origin.shape;
+    const TTL_offset_t sub_offset = internal_sub_tensor.origin.sub_offset;
+
+    // The part of the sub tensor inside the origin tensor, which is imported as usual.
+    TTL_offset_t begin;
+    TTL_offset_t end;
+
+    __TTL_sub_tensor_inside(shape, origin_shape, sub_offset, &begin, &end);
+
+    for (TTL_offset_dim_t z = 0; z < (TTL_offset_dim_t)shape.depth; z++) {
+        const bool plane_outside = (z < begin.z) || (z >= end.z);
+        const TTL_offset_dim_t ext_z = TTL_boundary_source(boundary, sub_offset.z + z, origin_shape.depth);
+
+        // The planes inside the tensor are imported together.
+        if ((plane_outside == false) && (z != begin.z)) continue;
+
+        const TTL_dim_t planes = plane_outside ? 1 : end.z - begin.z;
+
+        if (plane_outside && (end.x > begin.x) && (end.y > begin.y)) {
+            __TTL_import_boundary_block(
+                internal_sub_tensor,
+                const_external_tensor,
+                conversion,
+                event,
+                TTL_create_offset(begin.x, begin.y, z),
+                TTL_create_offset(sub_offset.x + begin.x, sub_offset.y + begin.y, ext_z),
+                TTL_create_shape(end.x - begin.x, end.y - begin.y, planes) __TTL_TRACE_LINE);
+        }
+
+        for (TTL_offset_dim_t y = 0; y < (TTL_offset_dim_t)shape.height; y++) {
+            const bool line_outside = (y < begin.y) || (y >= end.y);
+            const TTL_offset_dim_t ext_y = TTL_boundary_source(boundary, sub_offset.y + y, origin_shape.height);
+
+            // The columns to the left and right of the lines inside the tensor are imported whole.
+            if ((line_outside == false) && (y != begin.y)) continue;
+
+            const TTL_dim_t lines = line_outside ? 1 : end.y - begin.y;
+
+            if (line_outside && (end.x > begin.x)) {
+                __TTL_import_boundary_block(internal_sub_tensor,
+                                            const_external_tensor,
+                                            conversion,
+                                            event,
+                                            TTL_create_offset(begin.x, y, z),
+                                            TTL_create_offset(sub_offset.x + begin.x, ext_y, ext_z),
+                                            TTL_create_shape(end.x - begin.x, 1, planes) __TTL_TRACE_LINE);
+            }
+
+            for (TTL_offset_dim_t x = 0; x < (TTL_offset_dim_t)shape.width; x++) {
+                if ((x >= begin.x) && (x < end.x)) continue;
 
-    *src_address = (TTL_global(char *))const_external_tensor.base + (x_offset * const_external_tensor.elem_size) +
-                   (y_offset * const_external_tensor.layout.row_spacing * const_external_tensor.elem_size) +
-                   (z_offset * const_external_tensor.layout.plane_spacing * const_external_tensor.elem_size);
+                const TTL_offset_dim_t ext_x = TTL_boundary_source(boundary, sub_offset.x + x, origin_shape.width);
 
-    TTL_clear_void_space(internal_sub_tensor.tensor.base,
-                         x_offset,
-                         y_offset,
-                         internal_sub_tensor.tensor.elem_size,
-                         internal_sub_tensor.tensor.shape.width - x_cut,
-                         internal_sub_tensor.tensor.layout.row_spacing,
-                         internal_sub_tensor.tensor.shape.height - y_cut,
-                         internal_sub_tensor.tensor.shape.height,
-                         internal_sub_tensor.tensor.shape.depth);
+                __TTL_import_boundary_block(internal_sub_tensor,
+                                            const_external_tensor,
+                                            conversion,
+                                            event,
+                                            TTL_create_offset(x, y, z),
+                                            TTL_create_offset(ext_x, ext_y, ext_z),
+                                            TTL_create_shape(1, lines, planes) __TTL_TRACE_LINE);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Reduce the range of a dimension from begin to end to the part outside of the shared range
+ *
+ * @return 0 if the whole range is shared, 1 if the range was reduced, or -1 if the part outside
+ * of the shared range is not a single range.
+ */
+static inline int __TTL_unshared_range(const TTL_offset_dim_t shared_begin, const TTL_offset_dim_t shared_end,
+                                       TTL_offset_dim_t *const begin, TTL_offset_dim_t *const end) {
+    const bool from_begin = (shared_begin == *begin);
+    const bool to_end = (shared_end == *end);
+
+    if (from_begin && to_end) return 0;
+
+    if (from_begin) {
+        *begin = shared_end;
+    } else if (to_end) {
+        *end = shared_begin;
+    } else {
+        return -1;
+    }
+
+    return 1;
+}
+
+/**
+ * @brief Begin the import of an internal sub tensor, copying the elements it shares with the sub
+ * tensor imported before it from that sub tensor's buffer
+ *
+ * Consecutive tiles of an overlap tiler share the elements of their overlap. Where the elements
+ * of the origin tensor both sub tensors hold form a slab across the whole of the part of the
+ * sub tensor inside the origin tensor, for example the columns a tile shares with the tile to its
+ * left, the slab is copied within internal memory and only the rest is imported from the
+ * external tensor. The parts of the sub tensor outside of the origin tensor are filled as by
+ * TTL_import_sub_tensor.
+ *
+ * The previous sub tensor's import must be complete, and its buffer must not be written until
+ * the event is complete.
+ *
+ * @param internal_sub_tensor The sub tensor being imported to.
+ * @param const_external_tensor The external tensor being imported from, whose base is the element at
+ * the sub tensor's offset.
+ * @param prev_sub_tensor The sub tensor imported before, from the same origin tensor.
+ * @param conversion The conversion applied to each element, the elements of prev_sub_tensor have
+ * already been converted.
+ * @param event A pointer to the event which describes the transfer.
+ * @param padding_cache The padding last written to the internal buffer, @see TTL_import_pre_fill_cached
+ *
+ * @return false, having issued nothing, if the shared elements do not form such a slab or the
+ * import would reference the external tensor, @see TTL_ZERO_COPY_IMPORT
+ */
+static inline bool __TTL_TRACE_FN(TTL_import_sub_tensor_reusing, const TTL_int_sub_tensor_t internal_sub_tensor,
+                                  const TTL_const_ext_tensor_t const_external_tensor,
+                                  const TTL_const_int_sub_tensor_t prev_sub_tensor,
+                                  const TTL_conversion_t conversion, TTL_event_t *const event,
+                                  TTL_padding_cache_t *const padding_cache) {
+    if (TTL_shape_empty(prev_sub_tensor.tensor.shape) ||
+        (TTL_conversion_empty(conversion) && TTL_import_zero_copy(internal_sub_tensor, const_external_tensor)))
+        return false;
+
+#ifdef __TTL_ZERO_COPY_IMPORT_ENABLED
+    // The previous sub tensor may not have been copied to its buffer.
+    if (TTL_conversion_empty(conversion)) return false;
+#endif
+
+    TTL_offset_t begin;
+    TTL_offset_t end;
+    TTL_offset_t prev_begin;
+    TTL_offset_t prev_end;
+
+    __TTL_sub_tensor_inside(
+        internal_sub_tensor.tensor.shape, internal_sub_tensor.origin.shape, internal_sub_tensor.origin.sub_offset,
+        &begin, &end);
+    __TTL_sub_tensor_inside(
+        prev_sub_tensor.tensor.shape, prev_sub_tensor.origin.shape, prev_sub_tensor.origin.sub_offset,
+        &prev_begin, &prev_end);
+
+    // The position of the previous sub tensor in this one.
+    const TTL_offset_t prev_offset =
+        TTL_create_offset(prev_sub_tensor.origin.sub_offset.x - internal_sub_tensor.origin.sub_offset.x,
+                          prev_sub_tensor.origin.sub_offset.y - internal_sub_tensor.origin.sub_offset.y,
+                          prev_sub_tensor.origin.sub_offset.z - internal_sub_tensor.origin.sub_offset.z);
+    const TTL_offset_t shared_begin = TTL_create_offset(TTL_MAX(begin.x, prev_begin.x + prev_offset.x),
+                                                        TTL_MAX(begin.y, prev_begin.y + prev_offset.y),
+                                                        TTL_MAX(begin.z, prev_begin.z + prev_offset.z));
+    const TTL_offset_t shared_end = TTL_create_offset(TTL_MIN(end.x, prev_end.x + prev_offset.x),
+                                                      TTL_MIN(end.y, prev_end.y + prev_offset.y),
+                                                      TTL_MIN(end.z, prev_end.z + prev_offset.z));
+
+    if ((shared_begin.x >= shared_end.x) || (shared_begin.y >= shared_end.y) || (shared_begin.z >= shared_end.z))
+        return false;
+
+    // The elements that are not shared, which must be a single block.
+    TTL_offset_t new_begin = begin;
+    TTL_offset_t new_end = end;
+    const int x_reduced = __TTL_unshared_range(shared_begin.x, shared_end.x, &new_begin.x, &new_end.x);
+    const int y_reduced = __TTL_unshared_range(shared_begin.y, shared_end.y, &new_begin.y, &new_end.y);
+    const int z_reduced = __TTL_unshared_range(shared_begin.z, shared_end.z, &new_begin.z, &new_end.z);
+
+    if ((x_reduced < 0) || (y_reduced < 0) || (z_reduced < 0) || ((x_reduced + y_reduced + z_reduced) > 1))
+        return false;
+
+    // Every element is shared.
+    if ((x_reduced + y_reduced + z_reduced) == 0) new_end = new_begin;
+
+    TTL_local(void *) dst_address;
+    TTL_global(void *) src_address;
+
+    TTL_import_pre_fill_cached(internal_sub_tensor, const_external_tensor, &dst_address, &src_address, padding_cache);
+
+    const TTL_shape_t shared_shape = TTL_create_shape(
+        shared_end.x - shared_begin.x, shared_end.y - shared_begin.y, shared_end.z - shared_begin.z);
+    const TTL_int_tensor_t shared_to = TTL_create_int_tensor(internal_sub_tensor.tensor.base,
+                                                             shared_shape,
+                                                             internal_sub_tensor.tensor.layout,
+                                                             shared_begin,
+                                                             internal_sub_tensor.tensor.elem_size);
+    const TTL_const_int_tensor_t shared_from =
+        TTL_create_const_int_tensor(prev_sub_tensor.tensor.base,
+                                    shared_shape,
+                                    prev_sub_tensor.tensor.layout,
+                                    TTL_create_offset(shared_begin.x - prev_offset.x,
+                                                      shared_begin.y - prev_offset.y,
+                                                      shared_begin.z - prev_offset.z),
+                                    prev_sub_tensor.tensor.elem_size);
+
+    TTL_local_copy_base(shared_to, shared_from, event __TTL_TRACE_LINE);
+
+    if ((new_begin.x < new_end.x) && (new_begin.y < new_end.y) && (new_begin.z < new_end.z)) {
+        const TTL_shape_t new_shape =
+            TTL_create_shape(new_end.x - new_begin.x, new_end.y - new_begin.y, new_end.z - new_begin.z);
+        const TTL_int_tensor_t import_to = TTL_create_int_tensor(internal_sub_tensor.tensor.base,
+                                                                 new_shape,
+                                                                 internal_sub_tensor.tensor.layout,
+                                                                 new_begin,
+                                                                 internal_sub_tensor.tensor.elem_size);
+        const TTL_const_ext_tensor_t import_from = TTL_create_const_ext_tensor(const_external_tensor.base,
+                                                                               new_shape,
+                                                                               const_external_tensor.layout,
+                                                                               new_begin,
+                                                                               const_external_tensor.elem_size);
+
+        TTL_import_convert_base(import_to, import_from, conversion, event __TTL_TRACE_LINE);
+    }
+
+    __TTL_import_boundary(internal_sub_tensor, const_external_tensor, conversion, event __TTL_TRACE_LINE);
+
+    return true;
+}
+
+/**
+ * @brief Prepare the export of an internal sub tensor to an external tensor, leaving out the parts
+ * of the sub tensor outside of its origin tensor.
+ *
+ * The counterpart of TTL_import_pre_fill, so an output tile can have the same augmented geometry as
+ * an input tile. Elements outside of the origin tensor are computed but never written back.
+ *
+ * @param internal_sub_tensor The sub tensor being exported from.
+ * @param external_tensor The external tensor being exported to, whose base is the element at the
+ * sub tensor's offset.
+ * @param src_address Returns the internal address the first exported element is read from.
+ * @param dst_address Returns the external address the first exported element is written to.
+ *
+ * @return The shape of the part of the sub tensor that is exported, which is empty if the sub tensor
+ * lies wholly outside of its origin tensor.
+ */
+static inline TTL_shape_t TTL_export_clip(const TTL_const_int_sub_tensor_t internal_sub_tensor,
+                                          const TTL_ext_tensor_t external_tensor,
+                                          TTL_local(const void *) *const src_address,
+                                          TTL_global(void *) *const dst_address) {
+    TTL_offset_t begin;
+    TTL_offset_t end;
+
+    __TTL_sub_tensor_inside(internal_sub_tensor.tensor.shape,
+                            internal_sub_tensor.origin.shape,
+                            internal_sub_tensor.origin.sub_offset,
+                            &begin,
+                            &end);
+
+    *src_address = (TTL_local(const char *))internal_sub_tensor.tensor.base +
+                   (TTL_linearize(begin, internal_sub_tensor.tensor.layout) * internal_sub_tensor.tensor.elem_size);
+    *dst_address = (TTL_global(char *))external_tensor.base +
+                   (TTL_linearize(begin, external_tensor.layout) * external_tensor.elem_size);
+
+    return TTL_create_shape(end.x - begin.x, end.y - begin.y, end.z - begin.z);
+}
+
+/**
+ * @brief Return the external row that row of a gather or scatter maps to, or -1 if there is none.
+ *
+ * The indices are the elements of the first line of the index tensor. Rows beyond its width,
+ * and indices outside of the external tensor, map to no row.
+ */
+static inline TTL_offset_dim_t __TTL_gather_row(const TTL_const_int_int_tensor_t indices, const TTL_dim_t row,
+                                                const TTL_dim_t ext_rows) {
+    if (row >= indices.shape.width) return -1;
+
+    const int index = indices.base[row];
+
+    return ((index >= 0) && ((TTL_dim_t)index < ext_rows)) ? index : -1;
+}
+
+/**
+ * @brief Return the number of rows from row that map to consecutive external rows, so that
+ * they can be transferred as a single block.
+ *
+ * A run that starts with a row that maps to no external row extends only over the rows
+ * after it that map to none.
+ */
+static inline TTL_dim_t __TTL_gather_run(const TTL_const_int_int_tensor_t indices, const TTL_dim_t row,
+                                         const TTL_dim_t rows, const TTL_dim_t ext_rows) {
+    const TTL_offset_dim_t first = __TTL_gather_row(indices, row, ext_rows);
+    TTL_dim_t run = 1;
+
+    while ((row + run) < rows) {
+        const TTL_offset_dim_t next = __TTL_gather_row(indices, row + run, ext_rows);
+
+        if ((first < 0) ? (next >= 0) : (next != (first + (TTL_offset_dim_t)run))) break;
+        run++;
+    }
+
+    return run;
+}
+
+/**
+ * @brief Begin the import of the external rows named by an index tensor to the rows of an internal tensor
+ *
+ * Row y of each plane of the internal tensor is imported from row indices[y] of the same
+ * plane of the external tensor, so the external tensor is typically a table and the
+ * internal tensor receives one entry per index. Runs of consecutive indices are transferred
+ * as one block and all transfers are issued as one batch against the event.
+ *
+ * Internal rows with no valid index are filled with zero when the import is issued, as
+ * for TTL_import_pre_fill.
+ *
+ * @param internal_tensor A TTL_int_tensor_t describing the internal tensor, one row is gathered per line.
+ * @param external_tensor A TTL_const_ext_tensor_t describing the external tensor rows are gathered from.
+ * @param indices A TTL_const_int_int_tensor_t whose first line holds the indices, read before returning.
+ * @param event A pointer to the event which describes the transfers.
+ */
+static inline void __TTL_TRACE_FN(TTL_import_gather_base, const TTL_int_tensor_t internal_tensor,
+                                  const TTL_const_ext_tensor_t external_tensor,
+                                  const TTL_const_int_int_tensor_t indices, TTL_event_t *const event) {
+    TTL_COPY_BATCH_BEGIN();
 
-    return TTL_create_shape(internal_sub_tensor.tensor.shape.width - x_offset - x_cut,
-                            internal_sub_tensor.tensor.shape.height - y_offset - y_cut,
-                            internal_sub_tensor.tensor.shape.depth - z_offset - z_cut);
+    for (TTL_dim_t row = 0; row < internal_tensor.shape.height;) {
+        const TTL_offset_dim_t ext_row = __TTL_gather_row(indices, row, external_tensor.shape.height);
+        const TTL_dim_t rows =
+            __TTL_gather_run(indices, row, internal_tensor.shape.height, external_tensor.shape.height);
+        const TTL_shape_t shape = TTL_create_shape(internal_tensor.shape.width, rows, internal_tensor.shape.depth);
+        const TTL_int_tensor_t import_to = TTL_create_int_tensor(internal_tensor.base,
+                                                                 shape,
+                                                                 internal_tensor.layout,
+                                                                 TTL_create_offset(0, row),
+                                                                 internal_tensor.elem_size);
+
+        if (ext_row < 0) {
+            for (TTL_dim_t plane = 0; plane < shape.depth; plane++) {
+                for (TTL_dim_t line = 0; line < shape.height; line++) {
+                    TTL_local_memset((TTL_local(char *))import_to.base +
+                                         (((plane * import_to.layout.plane_spacing) +
+                                           (line * import_to.layout.row_spacing)) *
+                                          import_to.elem_size),
+                                     0,
+                                     shape.width * import_to.elem_size);
+                }
+            }
+        } else {
+            const TTL_const_ext_tensor_t import_from = TTL_create_const_ext_tensor(external_tensor.base,
+                                                                                   shape,
+                                                                                   external_tensor.layout,
+                                                                                   TTL_create_offset(0, ext_row),
+                                                                                   external_tensor.elem_size);
+
+            TTL_import_base(import_to, import_from, event __TTL_TRACE_LINE);
+        }
+
+        row += rows;
+    }
+
+    TTL_COPY_BATCH_END();
+}
+
+/**
+ * @brief Begin the export of the rows of an internal tensor to the external rows named by an index tensor
+ *
+ * The reverse of TTL_import_gather_base, row y of each plane of the internal tensor is
+ * exported to row indices[y] of the same plane of the external tensor. Rows with no valid
+ * index are not exported. Where two rows name the same external row the last one issued is
+ * not guaranteed to be the one written.
+ *
+ * @param internal_tensor A TTL_const_int_tensor_t describing the internal tensor, one row is scattered per line.
+ * @param external_tensor A TTL_ext_tensor_t describing the external tensor rows are scattered to.
+ * @param indices A TTL_const_int_int_tensor_t whose first line holds the indices, read before returning.
+ * @param event A pointer to the event which describes the transfers.
+ */
+static inline void __TTL_TRACE_FN(TTL_export_scatter_base, const TTL_const_int_tensor_t internal_tensor,
+                                  const TTL_ext_tensor_t external_tensor, const TTL_const_int_int_tensor_t indices,
+                                  TTL_event_t *const event) {
+    TTL_COPY_BATCH_BEGIN();
+
+    for (TTL_dim_t row = 0; row < internal_tensor.shape.height;) {
+        const TTL_offset_dim_t ext_row = __TTL_gather_row(indices, row, external_tensor.shape.height);
+        const TTL_dim_t rows =
+            __TTL_gather_run(indices, row, internal_tensor.shape.height, external_tensor.shape.height);
+
+        if (ext_row >= 0) {
+            const TTL_shape_t shape =
+                TTL_create_shape(internal_tensor.shape.width, rows, internal_tensor.shape.depth);
+            const TTL_const_int_tensor_t export_from = TTL_create_const_int_tensor(internal_tensor.base,
+                                                                                   shape,
+                                                                                   internal_tensor.layout,
+                                                                                   TTL_create_offset(0, row),
+                                                                                   internal_tensor.elem_size);
+            const TTL_ext_tensor_t export_to = TTL_create_ext_tensor(external_tensor.base,
+                                                                     shape,
+                                                                     external_tensor.layout,
+                                                                     TTL_create_offset(0, ext_row),
+                                                                     external_tensor.elem_size);
+
+            TTL_export_base(export_from, export_to, event __TTL_TRACE_LINE);
+        }
+
+        row += rows;
+    }
+
+    TTL_COPY_BATCH_END();
+}
+
+/**
+ * @def TTL_EVENT_POOL_SIZE
+ *
+ * @brief The number of events a TTL_event_pool_t holds.
+ */
+#ifndef TTL_EVENT_POOL_SIZE
+#define TTL_EVENT_POOL_SIZE 8
+#endif
+
+/**
+ * @brief A set of events that can be waited for together or one at a time as each completes
+ *
+ * A kernel running several pipelining schemes gives each scheme events from the same pool,
+ * TTL_wait_any_pool_event then returns whichever event completes first so that the kernel can
+ * compute on that scheme's buffer while the other transfers continue. Each event stays active,
+ * and so can be reused for further transfers, until it is given back with TTL_release_pool_event.
+ *
+ * @code
+ * TTL_event_pool_t pool = TTL_create_event_pool();
+ * TTL_event_t *const event_a = TTL_get_pool_event(&pool);
+ * TTL_event_t *const event_b = TTL_get_pool_event(&pool);
+ * ...
+ * TTL_event_t *const complete = TTL_wait_any_pool_event(&pool);
+ * @endcode
+ */
+typedef struct {
+    TTL_event_t events[TTL_EVENT_POOL_SIZE];  ///< The events, handed out by TTL_get_pool_event
+    bool active[TTL_EVENT_POOL_SIZE];         ///< The event has been handed out and not yet released
+} TTL_event_pool_t;
+
+/**
+ * @brief Create a TTL_event_pool_t with all of its events available
+ */
+static inline TTL_event_pool_t TTL_create_event_pool(__TTL_NO_PARAMETERS) {
+    TTL_event_pool_t result;
+
+    for (int i = 0; i < TTL_EVENT_POOL_SIZE; i++) {
+        result.events[i] = TTL_get_event();
+        result.active[i] = false;
+    }
+
+    return result;
+}
+
+/**
+ * @brief Hand out an empty event from a pool
+ *
+ * @return A pointer to the event, which remains valid for the life of the pool, or NULL if
+ * all of the events are active.
+ */
+static inline TTL_event_t *TTL_get_pool_event(TTL_event_pool_t *const event_pool) {
+    for (int i = 0; i < TTL_EVENT_POOL_SIZE; i++) {
+        if (event_pool->active[i] == false) {
+            event_pool->events[i] = TTL_get_event();
+            event_pool->active[i] = true;
+
+            return &event_pool->events[i];
+        }
+    }
+
+    return NULL;
 }
 
+/**
+ * @brief Wait for the transfers of an event and return it to its pool
+ *
+ * @param event_pool The pool the event was obtained from.
+ * @param event A pointer returned by TTL_get_pool_event.
+ */
+static inline void __TTL_TRACE_FN(TTL_release_pool_event, TTL_event_pool_t *const event_pool,
+                                  TTL_event_t *const event) {
+    TTL_wait(1, event __TTL_TRACE_LINE);
+    event_pool->active[event - event_pool->events] = false;
+}
+
+/**
+ * @brief Wait for the transfers of any one of the active events of a pool
+ *
+ * The complete event is set to the empty event, as by TTL_event_test, and stays active. An
+ * active event that has no transfers outstanding is complete, so a scheme that has finished
+ * should release its event for the other events to be waited for.
+ *
+ * @return A pointer to the complete event or NULL if no event is active.
+ */
+static inline TTL_event_t *__TTL_TRACE_FN(TTL_wait_any_pool_event, TTL_event_pool_t *const event_pool) {
+    TTL_event_t active_events[TTL_EVENT_POOL_SIZE];
+    int active_index[TTL_EVENT_POOL_SIZE];
+    int num_active = 0;
+
+    for (int i = 0; i < TTL_EVENT_POOL_SIZE; i++) {
+        if (event_pool->active[i]) {
+            active_events[num_active] = event_pool->events[i];
+            active_index[num_active++] = i;
+        }
+    }
+
+    const int complete = TTL_wait_any(num_active, active_events __TTL_TRACE_LINE);
+
+    if (complete < 0) return NULL;
+
+    event_pool->events[active_index[complete]] = active_events[complete];
+
+    return &event_pool->events[active_index[complete]];
+}
+
+/**
+ * @brief Wait for the transfers of all of the active events of a pool
+ *
+ * The events stay active.
+ */
+static inline void __TTL_TRACE_FN(TTL_wait_event_pool, TTL_event_pool_t *const event_pool) {
+    for (int i = 0; i < TTL_EVENT_POOL_SIZE; i++) {
+        if (event_pool->active[i]) TTL_wait(1, &event_pool->events[i] __TTL_TRACE_LINE);
+    }
+}
+
+#include "import_export/TTL_compressed_import_export.h"
 
 #define TTL_TYPES_INCLUDE_FILE "import_export/TTL_typed_import_export.h"
 #include "TTL_create_types.h"
+
+#include "import_export/TTL_converting_import_export.h"
@@ -30,3 +30,5 @@
 
 #define TTL_TYPES_INCLUDE_FILE "pipelines/TTL_duplex_scheme.h"
 #include "TTL_create_types.h"
+
+#include "pipelines/TTL_converting_schemes.h"
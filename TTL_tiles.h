@@ -33,8 +33,8 @@
  * this case the elements at (-1, -1, -1), (-1, 0, 0) etc. needed to be created
  * from a process of augmentation.
  *
- * Currently the only dynamic part of the augmentation is the size of the
- * augmentation the augmented values are simply hardcode.
+ * The augmentation describes how many elements are added on each side and, with
+ * its boundary, the values they take, @see TTL_boundary_t
  *
  * A TTL_augmented_dim_t is the number of elements to augment.
  */
@@ -57,6 +57,7 @@ typedef struct {
     TTL_augmented_dim_t bottom;  ///< Bottom augmentation in elements
     TTL_augmented_dim_t front;   ///< Front augmentation in elements
     TTL_augmented_dim_t back;    ///< Back augmentation in elements
+    TTL_boundary_t boundary;     ///< The values of the augmented elements
 } TTL_augmentation_t;
 
 /**
@@ -76,11 +77,53 @@ typedef struct {
 static inline TTL_augmentation_t __attribute__((overloadable))
 TTL_create_augmentation(const TTL_augmented_dim_t left, const TTL_augmented_dim_t right, const TTL_augmented_dim_t top,
                         const TTL_augmented_dim_t bottom, const TTL_augmented_dim_t front,
-                        const TTL_augmented_dim_t back) {
-    const TTL_augmentation_t res = { left, right, top, bottom, front, back };
+                        const TTL_augmented_dim_t back, const TTL_boundary_t boundary) {
+    const TTL_augmentation_t res = { left, right, top, bottom, front, back, boundary };
     return res;
 }
 
+/**
+ * @brief Create a 3D Description of a Tile augmentation with zero augmented elements
+ *
+ * @see TTL_overlap_t for more information.
+ *
+ * @param left       ///< Left hand augmentation in elements
+ * @param right      ///< Right hand augmentation in elements
+ * @param top        ///< Top augmentation in elements
+ * @param bottom     ///< Bottom augmentation in elements
+ * @param front      ///< Front augmentation in elements
+ * @param back     ///< Back augmentation in elements
+ *
+ * @return A TTL_augmentation_t describing in 3D the overlap requested.
+ */
+static inline TTL_augmentation_t __attribute__((overloadable))
+TTL_create_augmentation(const TTL_augmented_dim_t left, const TTL_augmented_dim_t right, const TTL_augmented_dim_t top,
+                        const TTL_augmented_dim_t bottom, const TTL_augmented_dim_t front,
+                        const TTL_augmented_dim_t back) {
+    return TTL_create_augmentation(left, right, top, bottom, front, back, TTL_create_boundary());
+}
+
+/**
+ * @brief Create a 2D Description of a Tile augmentation
+ *
+ * @see TTL_overlap_t for more information.
+ *
+ * @param left       ///< Left hand augmentation in elements
+ * @param right      ///< Right hand augmentation in elements
+ * @param top        ///< Top augmentation in elements
+ * @param bottom     ///< Bottom augmentation in elements
+ * @param boundary   ///< The values of the augmented elements
+ *
+ * front and back default to 0
+ *
+ * @return A TTL_augmentation_t describing in 3D the overlap requested.
+ */
+static inline TTL_augmentation_t __attribute__((overloadable))
+TTL_create_augmentation(TTL_augmented_dim_t left, TTL_augmented_dim_t right, TTL_augmented_dim_t top,
+                        TTL_augmented_dim_t bottom, TTL_boundary_t boundary) {
+    return TTL_create_augmentation(left, right, top, bottom, 0, 0, boundary);
+}
+
 /**
  * @brief Create a 2D Description of a Tile augmentation
  *
@@ -118,6 +161,24 @@ TTL_create_augmentation(TTL_augmented_dim_t left, TTL_augmented_dim_t right) {
     return TTL_create_augmentation(left, right, 0, 0, 0, 0);
 }
 
+/**
+ * @brief Create a 1D Description of a Tile augmentation
+ *
+ * @see TTL_overlap_t for more information.
+ *
+ * @param left       ///< Left hand augmentation in elements
+ * @param right      ///< Right hand augmentation in elements
+ * @param boundary   ///< The values of the augmented elements
+ *
+ * top, bottom, front and back default to 0
+ *
+ * @return A TTL_augmentation_t describing in 3D the overlap requested.
+ */
+static inline TTL_augmentation_t __attribute__((overloadable))
+TTL_create_augmentation(TTL_augmented_dim_t left, TTL_augmented_dim_t right, TTL_boundary_t boundary) {
+    return TTL_create_augmentation(left, right, 0, 0, 0, 0, boundary);
+}
+
 /***
  * @brief A Tile is described by its Shape and the offset from the beginning of
  * the Space
@@ -126,8 +187,9 @@ TTL_create_augmentation(TTL_augmented_dim_t left, TTL_augmented_dim_t right) {
  * the beginning of the space
  */
 typedef struct {
-    TTL_shape_t shape;    ///< @see TTL_shape_t
-    TTL_offset_t offset;  ///< @see TTL_offset_t
+    TTL_shape_t shape;        ///< @see TTL_shape_t
+    TTL_offset_t offset;      ///< @see TTL_offset_t
+    TTL_boundary_t boundary;  ///< The values of the elements of the tile outside of the space, @see TTL_boundary_t
 } TTL_tile_t;
 
 /**
@@ -269,7 +331,7 @@ static inline int TTL_tile_empty(TTL_tile_t tile) {
  * is the safest default state.
  */
 static inline TTL_tile_t TTL_create_empty_tile() {
-    TTL_tile_t result = { TTL_create_shape(0), TTL_create_offset(0, 0, 0) };
+    TTL_tile_t result = { TTL_create_shape(0), TTL_create_offset(0, 0, 0), TTL_create_boundary() };
     return result;
 }
 
@@ -293,6 +355,7 @@ static inline TTL_tile_t TTL_create_tile(TTL_dim_t x, TTL_dim_t y, TTL_dim_t z,
 
     // Set the tile shape, clamping at the end of each dimension
     result.shape = tiler.tile;
+    result.boundary = tiler.augmentation.boundary;
 
     if (x == tiler.cache.tiles_in_width - 1)
         result.shape.width = tiler.space.width - result.offset.x + tiler.augmentation.right;
@@ -358,3 +421,537 @@ static inline TTL_tile_t TTL_get_tile_column_major(const int tile_id, const TTL_
 
     return TTL_create_tile(x, y, z, tiler);
 }
+
+/**
+ * @brief Return the tile_id'th tile of a tile array in serpentine order.
+ *
+ * Rows of tiles are visited left to right and right to left in turn, and the planes
+ * alternately from the first row to the last and from the last row to the first, so that
+ * each tile is next to the tile before it, including where a row or plane ends. Overlapping
+ * tiles then share their halo with the tile before them throughout.
+ *
+ * @param tile_id The tile id to return - if out of bounds then an invalid tile is returned
+ * @param tiler The tiler containing the shape and tiling information
+ *
+ * @return The tile that is represented by tile_id when interpreted in serpentine order.
+ */
+static inline TTL_tile_t TTL_get_tile_serpentine(const int tile_id, const TTL_tiler_t tiler) {
+    if (!TTL_valid_tile_id(tile_id, tiler)) {
+        TTL_tile_t invalid = { 0 };
+        return invalid;
+    }
+
+    // Odd planes retrace the order of the even planes, so start where the plane before ended.
+    const TTL_dim_t z = tile_id / tiler.cache.tiles_in_plane;
+    const TTL_dim_t forward_tid_in_plane = tile_id % tiler.cache.tiles_in_plane;
+    const TTL_dim_t tid_in_plane =
+        (z & 1) ? (tiler.cache.tiles_in_plane - 1 - forward_tid_in_plane) : forward_tid_in_plane;
+    const TTL_dim_t y = tid_in_plane / tiler.cache.tiles_in_width;
+    const TTL_dim_t forward_x = tid_in_plane % tiler.cache.tiles_in_width;
+    const TTL_dim_t x = (y & 1) ? (tiler.cache.tiles_in_width - 1 - forward_x) : forward_x;
+
+    return TTL_create_tile(x, y, z, tiler);
+}
+
+/**
+ * @brief Return the smallest power of two that is at least n, and at least 1
+ *
+ * Internal TTL function not part of the API.
+ */
+static inline TTL_dim_t __TTL_curve_size(const TTL_dim_t n) {
+    TTL_dim_t size = 1;
+
+    while (size < n) size *= 2;
+
+    return size;
+}
+
+/**
+ * @brief Return the number of the size positions from begin that are less than end
+ *
+ * Internal TTL function not part of the API.
+ */
+static inline TTL_dim_t __TTL_curve_extent(const TTL_dim_t begin, const TTL_dim_t size, const TTL_dim_t end) {
+    return (begin >= end) ? 0 : (((end - begin) < size) ? (end - begin) : size);
+}
+
+/**
+ * @brief Return the tile_id'th tile of a tile array in Morton (Z) order.
+ *
+ * The tiles are visited in the order of a Z-order curve over a cube of a power of two tiles
+ * in each dimension, so that tiles visited one after another are close in all three
+ * dimensions. Positions of the cube outside of the tile array are skipped, so every tile
+ * id from 0 to TTL_number_of_tiles - 1 is a tile whatever the number of tiles in each
+ * dimension.
+ *
+ * The position is found by descending the octree of the cube, counting the tiles in each
+ * octant, so takes a number of steps in proportion to the log of the larger dimension.
+ *
+ * @param tile_id The tile id to return - if out of bounds then an invalid tile is returned
+ * @param tiler The tiler containing the shape and tiling information
+ *
+ * @return The tile that is represented by tile_id when interpreted in Morton order.
+ */
+static inline TTL_tile_t TTL_get_tile_morton(const int tile_id, const TTL_tiler_t tiler) {
+    if (!TTL_valid_tile_id(tile_id, tiler)) {
+        TTL_tile_t invalid = { 0 };
+        return invalid;
+    }
+
+    const TTL_dim_t tiles_in_width = tiler.cache.tiles_in_width;
+    const TTL_dim_t tiles_in_height = tiler.cache.tiles_in_height;
+    const TTL_dim_t tiles_in_depth = tiler.cache.tiles_in_depth;
+    const TTL_dim_t largest_in_plane = (tiles_in_width > tiles_in_height) ? tiles_in_width : tiles_in_height;
+    const TTL_dim_t largest = (largest_in_plane > tiles_in_depth) ? largest_in_plane : tiles_in_depth;
+    TTL_dim_t remaining = tile_id;
+    TTL_dim_t x = 0;
+    TTL_dim_t y = 0;
+    TTL_dim_t z = 0;
+
+    for (TTL_dim_t size = __TTL_curve_size(largest) / 2; size > 0; size /= 2) {
+        // The octants in Z order, x changing fastest.
+        for (unsigned int octant = 0; octant < 8; octant++) {
+            const TTL_dim_t octant_x = x + ((octant & 1) ? size : 0);
+            const TTL_dim_t octant_y = y + ((octant & 2) ? size : 0);
+            const TTL_dim_t octant_z = z + ((octant & 4) ? size : 0);
+            const TTL_dim_t tiles_in_octant = __TTL_curve_extent(octant_x, size, tiles_in_width) *
+                                              __TTL_curve_extent(octant_y, size, tiles_in_height) *
+                                              __TTL_curve_extent(octant_z, size, tiles_in_depth);
+
+            if (remaining < tiles_in_octant) {
+                x = octant_x;
+                y = octant_y;
+                z = octant_z;
+                break;
+            }
+
+            remaining -= tiles_in_octant;
+        }
+    }
+
+    return TTL_create_tile(x, y, z, tiler);
+}
+
+/**
+ * @brief Return the tile_id'th tile of a tile array in Hilbert order.
+ *
+ * The tiles of each plane are visited in the order of a Hilbert curve over a square of a
+ * power of two tiles, the planes one after another. Each tile of a square is next to the
+ * tile before it, and positions of the square outside of the tile array are skipped so
+ * every tile id from 0 to TTL_number_of_tiles - 1 is a tile. Where the number of tiles
+ * in the width and height are not the same power of two the curve may jump over the
+ * skipped positions, but tiles remain close to those before them.
+ *
+ * The position is found by descending the quadtree of the square, keeping the rotation and
+ * reflection of the curve in each quadrant, so takes a number of steps in proportion to the
+ * log of the larger dimension.
+ *
+ * @param tile_id The tile id to return - if out of bounds then an invalid tile is returned
+ * @param tiler The tiler containing the shape and tiling information
+ *
+ * @return The tile that is represented by tile_id when interpreted in Hilbert order.
+ */
+static inline TTL_tile_t TTL_get_tile_hilbert(const int tile_id, const TTL_tiler_t tiler) {
+    if (!TTL_valid_tile_id(tile_id, tiler)) {
+        TTL_tile_t invalid = { 0 };
+        return invalid;
+    }
+
+    const TTL_dim_t tiles_in_width = tiler.cache.tiles_in_width;
+    const TTL_dim_t tiles_in_height = tiler.cache.tiles_in_height;
+    const TTL_dim_t z = tile_id / tiler.cache.tiles_in_plane;
+    const TTL_dim_t largest = (tiles_in_width > tiles_in_height) ? tiles_in_width : tiles_in_height;
+    TTL_dim_t remaining = tile_id % tiler.cache.tiles_in_plane;
+    TTL_dim_t x = 0;
+    TTL_dim_t y = 0;
+
+    // The curve within the current square is the basic curve, visiting the quadrants
+    // (0, 0), (0, 1), (1, 1), (1, 0), with x and y exchanged if swap and then reflected.
+    unsigned int swap = 0;
+    unsigned int reflect_x = 0;
+    unsigned int reflect_y = 0;
+
+    for (TTL_dim_t size = __TTL_curve_size(largest) / 2; size > 0; size /= 2) {
+        for (unsigned int quadrant = 0; quadrant < 4; quadrant++) {
+            const unsigned int a = quadrant >> 1;
+            const unsigned int b = (quadrant ^ (quadrant >> 1)) & 1;
+            const TTL_dim_t quadrant_x = x + (((swap ? b : a) ^ reflect_x) ? size : 0);
+            const TTL_dim_t quadrant_y = y + (((swap ? a : b) ^ reflect_y) ? size : 0);
+            const TTL_dim_t tiles_in_quadrant = __TTL_curve_extent(quadrant_x, size, tiles_in_width) *
+                                                __TTL_curve_extent(quadrant_y, size, tiles_in_height);
+
+            if (remaining < tiles_in_quadrant) {
+                x = quadrant_x;
+                y = quadrant_y;
+
+                // The first quadrant's curve is transposed and the last's transposed and
+                // reflected in both axes, so that each joins the next quadrant's.
+                if ((quadrant == 0) || (quadrant == 3)) {
+                    const unsigned int reflect = (quadrant == 3);
+
+                    swap ^= 1;
+                    reflect_x ^= reflect;
+                    reflect_y ^= reflect;
+                }
+
+                break;
+            }
+
+            remaining -= tiles_in_quadrant;
+        }
+    }
+
+    return TTL_create_tile(x, y, z, tiler);
+}
+
+/**
+ * @brief Step through the tiles of a tiler in row-major order, as TTL_get_tile
+ *
+ * The pipelining schemes need the tile being computed on and the tile after it. Rather than
+ * recovering the coordinates of each from its tile id, with divisions, the iterator moves on
+ * from one tile to the next by additions alone.
+ *
+ * @code
+ * TTL_tile_iterator_t tiles = TTL_create_tile_iterator(tiler);
+ *
+ * for (; TTL_tile_iterator_valid(&tiles); TTL_advance_tile_iterator(&tiles)) {
+ *     TTL_tile_t tile_next_import = TTL_look_ahead_tile(&tiles);  // TTL_get_tile(i + 1, tiler)
+ *     TTL_tile_t tile_current_export = TTL_current_tile(&tiles);  // TTL_get_tile(i, tiler)
+ *     ...
+ * }
+ * @endcode
+ */
+typedef struct {
+    int tile_id;               ///< The tile id of current
+    int end_tile_id;           ///< The tile id after the last tile iterated over
+    int tile_id_step;          ///< The distance between the tile ids of consecutive tiles
+    TTL_tile_t current;        ///< The tile_id'th tile
+    TTL_tile_t look_ahead;     ///< The tile after current, or the invalid tile if there is none
+    TTL_dim_t x;               ///< The x position of look_ahead
+    TTL_dim_t y;               ///< The y position of look_ahead
+    TTL_dim_t z;               ///< The z position of look_ahead
+    TTL_shape_t tiles_in;      ///< The number of tiles in each dimension
+    TTL_shape_t tiles_step;    ///< tile_id_step as a number of tiles in each dimension, with carries
+    TTL_offset_t first_offset; ///< The offset of the first tile
+    TTL_offset_t step;         ///< The distance between the offsets of adjacent tiles
+    TTL_shape_t tile;          ///< The shape of each tile, except for the last of each dimension
+    TTL_shape_t last_tile;     ///< The shape of the last tile of each dimension
+} TTL_tile_iterator_t;
+
+/**
+ * @brief Move the look ahead tile of an iterator on by one tile in row-major order
+ *
+ * Internal TTL function not part of the API.
+ */
+static inline void __TTL_next_look_ahead(TTL_tile_iterator_t *const iterator) {
+    iterator->look_ahead.offset.x += iterator->step.x;
+
+    if (++iterator->x == iterator->tiles_in.width) {
+        iterator->x = 0;
+        iterator->look_ahead.offset.x = iterator->first_offset.x;
+        iterator->look_ahead.offset.y += iterator->step.y;
+
+        if (++iterator->y == iterator->tiles_in.height) {
+            iterator->y = 0;
+            iterator->look_ahead.offset.y = iterator->first_offset.y;
+            iterator->look_ahead.offset.z += iterator->step.z;
+
+            if (++iterator->z == iterator->tiles_in.depth) {
+                const TTL_tile_t invalid = { 0 };
+
+                iterator->look_ahead = invalid;
+                return;
+            }
+
+            iterator->look_ahead.shape.depth =
+                (iterator->z == iterator->tiles_in.depth - 1) ? iterator->last_tile.depth : iterator->tile.depth;
+        }
+
+        iterator->look_ahead.shape.height =
+            (iterator->y == iterator->tiles_in.height - 1) ? iterator->last_tile.height : iterator->tile.height;
+    }
+
+    iterator->look_ahead.shape.width =
+        (iterator->x == iterator->tiles_in.width - 1) ? iterator->last_tile.width : iterator->tile.width;
+}
+
+/**
+ * @brief Move the look ahead tile of an iterator on by tile_id_step tiles in row-major order
+ *
+ * Each position is moved on by tiles_step, carrying into the next dimension, so the cost does not
+ * depend on tile_id_step. The tile moved to must be a tile of the tiler.
+ *
+ * Internal TTL function not part of the API.
+ */
+static inline void __TTL_jump_look_ahead(TTL_tile_iterator_t *const iterator) {
+    TTL_dim_t carry = 0;
+
+    iterator->x += iterator->tiles_step.width;
+
+    if (iterator->x >= iterator->tiles_in.width) {
+        iterator->x -= iterator->tiles_in.width;
+        carry = 1;
+    }
+
+    iterator->y += iterator->tiles_step.height + carry;
+    carry = 0;
+
+    if (iterator->y >= iterator->tiles_in.height) {
+        iterator->y -= iterator->tiles_in.height;
+        carry = 1;
+    }
+
+    iterator->z += iterator->tiles_step.depth + carry;
+
+    iterator->look_ahead.offset = TTL_create_offset(iterator->first_offset.x + (iterator->x * iterator->step.x),
+                                                    iterator->first_offset.y + (iterator->y * iterator->step.y),
+                                                    iterator->first_offset.z + (iterator->z * iterator->step.z));
+    iterator->look_ahead.shape = TTL_create_shape(
+        (iterator->x == iterator->tiles_in.width - 1) ? iterator->last_tile.width : iterator->tile.width,
+        (iterator->y == iterator->tiles_in.height - 1) ? iterator->last_tile.height : iterator->tile.height,
+        (iterator->z == iterator->tiles_in.depth - 1) ? iterator->last_tile.depth : iterator->tile.depth);
+}
+
+/**
+ * @brief Move the look ahead tile of an iterator on to the tile tile_id_step after current
+ *
+ * Internal TTL function not part of the API.
+ */
+static inline void __TTL_advance_look_ahead(TTL_tile_iterator_t *const iterator) {
+    if ((iterator->tile_id + iterator->tile_id_step) >= iterator->end_tile_id) {
+        const TTL_tile_t invalid = { 0 };
+
+        iterator->look_ahead = invalid;
+        return;
+    }
+
+    if (iterator->tile_id_step == 1) {
+        __TTL_next_look_ahead(iterator);
+    } else {
+        __TTL_jump_look_ahead(iterator);
+    }
+}
+
+/**
+ * @brief Create an iterator over every tile_id_step'th tile from first_tile_id to end_tile_id
+ *
+ * Internal TTL function not part of the API.
+ */
+static inline TTL_tile_iterator_t __TTL_create_tile_iterator(const TTL_tiler_t tiler, const int first_tile_id,
+                                                             const int end_tile_id, const int tile_id_step) {
+    TTL_tile_iterator_t result;
+    const TTL_tile_t last = TTL_create_tile(
+        tiler.cache.tiles_in_width - 1, tiler.cache.tiles_in_height - 1, tiler.cache.tiles_in_depth - 1, tiler);
+
+    result.tile_id = first_tile_id;
+    result.end_tile_id = end_tile_id;
+    result.tile_id_step = tile_id_step;
+    result.z = first_tile_id / tiler.cache.tiles_in_plane;
+    result.y = (first_tile_id % tiler.cache.tiles_in_plane) / tiler.cache.tiles_in_width;
+    result.x = (first_tile_id % tiler.cache.tiles_in_plane) % tiler.cache.tiles_in_width;
+    result.tiles_in =
+        TTL_create_shape(tiler.cache.tiles_in_width, tiler.cache.tiles_in_height, tiler.cache.tiles_in_depth);
+    result.tiles_step = TTL_create_shape(tile_id_step % tiler.cache.tiles_in_width,
+                                         (tile_id_step % tiler.cache.tiles_in_plane) / tiler.cache.tiles_in_width,
+                                         tile_id_step / tiler.cache.tiles_in_plane);
+    result.first_offset =
+        TTL_create_offset(-tiler.augmentation.left, -tiler.augmentation.top, -tiler.augmentation.front);
+    result.step = TTL_create_offset(tiler.tile.width - tiler.overlap.width,
+                                    tiler.tile.height - tiler.overlap.height,
+                                    tiler.tile.depth - tiler.overlap.depth);
+    result.tile = tiler.tile;
+    result.last_tile = last.shape;
+
+    // An empty range has neither a current nor a look ahead tile.
+    const TTL_tile_t invalid = { 0 };
+
+    result.look_ahead = (first_tile_id < end_tile_id) ? TTL_get_tile(first_tile_id, tiler) : invalid;
+    result.current = result.look_ahead;
+    __TTL_advance_look_ahead(&result);
+
+    return result;
+}
+
+/**
+ * @brief Create an iterator whose current tile is the first tile of a tiler
+ *
+ * @param tiler The tiler whose tiles are iterated over.
+ *
+ * @return A TTL_tile_iterator_t whose current tile is TTL_get_tile(0, tiler)
+ */
+static inline TTL_tile_iterator_t TTL_create_tile_iterator(const TTL_tiler_t tiler) {
+    return __TTL_create_tile_iterator(tiler, 0, TTL_number_of_tiles(tiler), 1);
+}
+
+/**
+ * @brief Return true while the current tile of an iterator is a tile of its tiler
+ */
+static inline bool TTL_tile_iterator_valid(const TTL_tile_iterator_t *const iterator) {
+    return iterator->tile_id < iterator->end_tile_id;
+}
+
+/**
+ * @brief Return the tile_id'th tile, as TTL_get_tile(tile_id, tiler)
+ */
+static inline TTL_tile_t TTL_current_tile(const TTL_tile_iterator_t *const iterator) {
+    return iterator->current;
+}
+
+/**
+ * @brief Return the tile after the current tile, as TTL_get_tile(tile_id + 1, tiler)
+ *
+ * After the last tile the invalid tile is returned, as TTL_get_tile does for an id that is
+ * out of range. The last tile of an iterator over a partition is the last tile of the
+ * partition, @see TTL_create_partition_tile_iterator
+ */
+static inline TTL_tile_t TTL_look_ahead_tile(const TTL_tile_iterator_t *const iterator) {
+    return iterator->look_ahead;
+}
+
+/**
+ * @brief Move an iterator on to the next tile
+ *
+ * Once the last tile has been passed both the current and the look ahead tiles are invalid.
+ */
+static inline void TTL_advance_tile_iterator(TTL_tile_iterator_t *const iterator) {
+    if (!TTL_tile_iterator_valid(iterator)) return;
+
+    iterator->tile_id += iterator->tile_id_step;
+    iterator->current = iterator->look_ahead;
+    __TTL_advance_look_ahead(iterator);
+}
+
+/**
+ * @brief How the tiles of a tiler are divided between work-groups
+ *
+ * - TTL_PARTITION_CONTIGUOUS gives each work-group a run of consecutive tile ids, so consecutive
+ *   tiles of a work-group are neighbours as they are for a single work-group.
+ * - TTL_PARTITION_INTERLEAVED gives work-group g the tile ids g, g + number_of_groups, ... so
+ *   the work-groups move through the tensor together.
+ */
+typedef enum {
+    TTL_PARTITION_CONTIGUOUS,   ///< Each work-group has a run of consecutive tile ids
+    TTL_PARTITION_INTERLEAVED,  ///< Work-groups take every number_of_groups'th tile id in turn
+} TTL_partition_t;
+
+/**
+ * @brief The tile ids of a tiler processed by one work-group
+ *
+ * The tile ids are first_tile_id, first_tile_id + tile_id_step, ... number_of_tiles of them.
+ *
+ * Each work-group runs a complete pipelining scheme over its own tiles: the scheme is started
+ * with the first tile of the partition, the tile looked ahead to after the last tile of the
+ * partition is the invalid tile, so no work-group imports a tile of another, and finishing the
+ * scheme exports the last tile of the partition.
+ *
+ * @code
+ * const TTL_tile_partition_t partition = TTL_create_group_tile_partition(tiler, TTL_PARTITION_CONTIGUOUS);
+ * TTL_tile_iterator_t tiles = TTL_create_partition_tile_iterator(tiler, partition);
+ * TTL_import_double_const_uchar_tensor_buffering_t import_db = TTL_start_import_double_buffering(
+ *     l_in1, l_in2, ext_input_tensor, &import_e, TTL_current_tile(&tiles));
+ *
+ * for (; TTL_tile_iterator_valid(&tiles); TTL_advance_tile_iterator(&tiles)) {
+ *     TTL_int_uchar_sub_tensor_t imported_to = TTL_step_buffering(&import_db, TTL_look_ahead_tile(&tiles));
+ *     ...
+ * }
+ *
+ * TTL_finish_buffering(&import_db);
+ * @endcode
+ */
+typedef struct {
+    int first_tile_id;    ///< The tile id of the first tile of the partition
+    int tile_id_step;     ///< The distance between the tile ids of consecutive tiles of the partition
+    int number_of_tiles;  ///< The number of tiles in the partition, which may be 0
+} TTL_tile_partition_t;
+
+/**
+ * @brief Return the tiles of a tiler processed by a work-group
+ *
+ * The tiles are divided as evenly as possible, the number of tiles of any two work-groups
+ * differing by at most one. Work-groups beyond the number of tiles have an empty partition.
+ *
+ * @param tiler The tiler whose tiles are divided.
+ * @param group_id The work-group, from 0 to number_of_groups - 1.
+ * @param number_of_groups The number of work-groups the tiles are divided between.
+ * @param partition How the tiles are divided, @see TTL_partition_t
+ *
+ * @return The TTL_tile_partition_t of work-group group_id.
+ */
+static inline TTL_tile_partition_t TTL_create_tile_partition(const TTL_tiler_t tiler, const int group_id,
+                                                             const int number_of_groups,
+                                                             const TTL_partition_t partition) {
+    const int number_of_tiles = TTL_number_of_tiles(tiler);
+    TTL_tile_partition_t result = { 0, 1, 0 };
+
+    if ((group_id < 0) || (group_id >= number_of_groups)) return result;
+
+    if (partition == TTL_PARTITION_INTERLEAVED) {
+        result.first_tile_id = group_id;
+        result.tile_id_step = number_of_groups;
+        result.number_of_tiles =
+            (group_id < number_of_tiles) ? ((number_of_tiles - 1 - group_id) / number_of_groups) + 1 : 0;
+    } else {
+        // The first number_of_tiles % number_of_groups work-groups have one tile more than the others.
+        const int tiles_per_group = number_of_tiles / number_of_groups;
+        const int remainder = number_of_tiles % number_of_groups;
+
+        result.first_tile_id = (group_id * tiles_per_group) + ((group_id < remainder) ? group_id : remainder);
+        result.number_of_tiles = tiles_per_group + ((group_id < remainder) ? 1 : 0);
+    }
+
+    return result;
+}
+
+/**
+ * @brief Return the tiles of a tiler processed by the calling work-group
+ *
+ * The work-group and the number of work-groups are those along the first dimension of the
+ * NDRange, @see TTL_GROUP_ID and TTL_NUMBER_OF_GROUPS
+ *
+ * @param tiler The tiler whose tiles are divided.
+ * @param partition How the tiles are divided, @see TTL_partition_t
+ *
+ * @return The TTL_tile_partition_t of the calling work-group.
+ */
+static inline TTL_tile_partition_t TTL_create_group_tile_partition(const TTL_tiler_t tiler,
+                                                                   const TTL_partition_t partition) {
+    return TTL_create_tile_partition(tiler, (int)TTL_GROUP_ID, (int)TTL_NUMBER_OF_GROUPS, partition);
+}
+
+/**
+ * @brief Return the tile_id'th tile of a partition
+ *
+ * @param tile_id The tile of the partition to return, from 0 to partition.number_of_tiles - 1
+ * @param partition The partition of the tiler.
+ * @param tiler The tiler that was partitioned.
+ *
+ * @return The tile, or the invalid tile if tile_id is not a tile of the partition.
+ */
+static inline TTL_tile_t TTL_get_partition_tile(const int tile_id, const TTL_tile_partition_t partition,
+                                                const TTL_tiler_t tiler) {
+    if ((tile_id < 0) || (tile_id >= partition.number_of_tiles)) {
+        TTL_tile_t invalid = { 0 };
+        return invalid;
+    }
+
+    return TTL_get_tile(partition.first_tile_id + (tile_id * partition.tile_id_step), tiler);
+}
+
+/**
+ * @brief Create an iterator whose current tile is the first tile of a partition
+ *
+ * The iterator steps through the tiles of the partition only, with TTL_look_ahead_tile
+ * returning the invalid tile for the last of them.
+ *
+ * @param tiler The tiler that was partitioned.
+ * @param partition The tiles to iterate over, @see TTL_create_tile_partition
+ *
+ * @return A TTL_tile_iterator_t whose current tile is TTL_get_partition_tile(0, partition, tiler)
+ */
+static inline TTL_tile_iterator_t TTL_create_partition_tile_iterator(const TTL_tiler_t tiler,
+                                                                     const TTL_tile_partition_t partition) {
+    return __TTL_create_tile_iterator(tiler,
+                                      partition.first_tile_id,
+                                      partition.first_tile_id + (partition.number_of_tiles * partition.tile_id_step),
+                                      partition.tile_id_step);
+}
@@ -28,6 +28,7 @@
 #if __TTL_DEBUG > 0
 
 #define TTL_import_sub_tensor(...) TTL_import_sub_tensor(__VA_ARGS__, __LINE__)
+#define TTL_export_sub_tensor(...) TTL_export_sub_tensor(__VA_ARGS__, __LINE__)
 
 #define TTL_import(...) TTL_import(__VA_ARGS__, __LINE__)
 #define TTL_blocking_import(...) TTL_blocking_import(__VA_ARGS__, __LINE__)
@@ -35,6 +36,25 @@
 #define TTL_export(...) TTL_export(__VA_ARGS__, __LINE__)
 #define TTL_blocking_export(...) TTL_blocking_export(__VA_ARGS__, __LINE__)
 
+#define TTL_submit_batch(...) TTL_submit_batch(__VA_ARGS__, __LINE__)
+
+#define TTL_wait_any(...) TTL_wait_any(__VA_ARGS__, __LINE__)
+#define TTL_release_pool_event(...) TTL_release_pool_event(__VA_ARGS__, __LINE__)
+#define TTL_wait_any_pool_event(...) TTL_wait_any_pool_event(__VA_ARGS__, __LINE__)
+#define TTL_wait_event_pool(...) TTL_wait_event_pool(__VA_ARGS__, __LINE__)
+
+#define TTL_import_gather(...) TTL_import_gather(__VA_ARGS__, __LINE__)
+#define TTL_export_scatter(...) TTL_export_scatter(__VA_ARGS__, __LINE__)
+
+#define TTL_import_permuted(...) TTL_import_permuted(__VA_ARGS__, __LINE__)
+#define TTL_export_permuted(...) TTL_export_permuted(__VA_ARGS__, __LINE__)
+
+#define TTL_import_convert(...) TTL_import_convert(__VA_ARGS__, __LINE__)
+#define TTL_export_convert(...) TTL_export_convert(__VA_ARGS__, __LINE__)
+
+#define TTL_import_compressed(...) TTL_import_compressed(__VA_ARGS__, __LINE__)
+#define TTL_export_compressed(...) TTL_export_compressed(__VA_ARGS__, __LINE__)
+
 #define TTL_step_buffering(...) TTL_step_buffering(__VA_ARGS__, __LINE__)
 
 #define TTL_start_simplex_buffering(...) TTL_start_simplex_buffering(__VA_ARGS__, __LINE__)
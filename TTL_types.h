@@ -154,6 +154,211 @@ static inline __attribute__((overloadable)) TTL_offset_t TTL_create_offset(__TTL
     return TTL_create_offset(0, 0, 0);
 }
 
+/******************************************************
+ * PERMUTATION
+ *****************************************************/
+
+typedef unsigned char TTL_axis_t;  ///< An axis of a tensor, 0 for x, 1 for y and 2 for z
+
+/**
+ * @brief Description of the axis order of a tensor relative to another.
+ *
+ * Each member is the axis of the other tensor that the axis of this tensor runs along,
+ * so { 1, 0, 2 } transposes the x and y axes and { 1, 2, 0 } turns an HWC tensor, with
+ * channels along x, into a CHW tensor with width along x.
+ */
+typedef struct {
+    TTL_axis_t x;  ///< The axis that x runs along
+    TTL_axis_t y;  ///< The axis that y runs along
+    TTL_axis_t z;  ///< The axis that z runs along
+} TTL_permutation_t;
+
+/**
+ * @brief Create a description of an axis permutation
+ *
+ * @see TTL_permutation_t for more information.
+ *
+ * @param x The axis that x runs along
+ * @param y The axis that y runs along
+ * @param z The axis that z runs along
+ *
+ * The axes must be 0, 1 and 2 in some order.
+ *
+ * @return A TTL_permutation_t describing the permutation requested.
+ */
+static inline TTL_permutation_t __attribute__((overloadable))
+TTL_create_permutation(const TTL_axis_t x, const TTL_axis_t y, const TTL_axis_t z) {
+    const TTL_permutation_t res = { x, y, z };
+    return res;
+}
+
+/**
+ * @brief Create a description of a 2D axis permutation
+ *
+ * @see TTL_permutation_t for more information.
+ *
+ * @param x The axis that x runs along
+ * @param y The axis that y runs along
+ *
+ * z defaults to 2
+ *
+ * @return A TTL_permutation_t describing the permutation requested.
+ */
+static inline TTL_permutation_t __attribute__((overloadable))
+TTL_create_permutation(const TTL_axis_t x, const TTL_axis_t y) {
+    return TTL_create_permutation(x, y, 2);
+}
+
+/**
+ * @brief Return the shape of a tensor of shape permuted by permutation
+ *
+ * @param shape The shape of the tensor the permutation is relative to.
+ * @param permutation The axis of shape that each axis of the result runs along.
+ */
+static inline TTL_shape_t TTL_permute_shape(const TTL_shape_t shape, const TTL_permutation_t permutation) {
+    const TTL_dim_t dims[3] = { shape.width, shape.height, shape.depth };
+
+    return TTL_create_shape(dims[permutation.x], dims[permutation.y], dims[permutation.z]);
+}
+
+/******************************************************
+ * CONVERSION
+ *****************************************************/
+
+/**
+ * @brief The element types a transfer can convert between.
+ */
+typedef enum {
+    TTL_ELEMENT_CHAR,
+    TTL_ELEMENT_UCHAR,
+    TTL_ELEMENT_SHORT,
+    TTL_ELEMENT_USHORT,
+    TTL_ELEMENT_INT,
+    TTL_ELEMENT_UINT,
+    TTL_ELEMENT_LONG,
+    TTL_ELEMENT_ULONG,
+} TTL_element_type_t;
+
+/**
+ * @def __TTL_for_each_element_type
+ *
+ * @brief Expand macro(type, element_type, ...) for each type of TTL_element_type_t
+ */
+#define __TTL_for_each_element_type(macro, ...)    \
+    macro(char, TTL_ELEMENT_CHAR, __VA_ARGS__)     \
+    macro(uchar, TTL_ELEMENT_UCHAR, __VA_ARGS__)   \
+    macro(short, TTL_ELEMENT_SHORT, __VA_ARGS__)   \
+    macro(ushort, TTL_ELEMENT_USHORT, __VA_ARGS__) \
+    macro(int, TTL_ELEMENT_INT, __VA_ARGS__)       \
+    macro(uint, TTL_ELEMENT_UINT, __VA_ARGS__)     \
+    macro(long, TTL_ELEMENT_LONG, __VA_ARGS__)     \
+    macro(ulong, TTL_ELEMENT_ULONG, __VA_ARGS__)
+
+/**
+ * @brief Return the size in bytes of an element of type
+ */
+static inline TTL_dim_t TTL_element_size(const TTL_element_type_t type) {
+    switch (type) {
+        case TTL_ELEMENT_CHAR:
+        case TTL_ELEMENT_UCHAR:
+            return sizeof(char);
+        case TTL_ELEMENT_SHORT:
+        case TTL_ELEMENT_USHORT:
+            return sizeof(short);
+        case TTL_ELEMENT_INT:
+        case TTL_ELEMENT_UINT:
+            return sizeof(int);
+        default:
+            return sizeof(long);
+    }
+}
+
+/**
+ * @brief How a transfer converts each element.
+ */
+typedef enum {
+    TTL_CONVERT_NONE,      ///< Elements are copied unchanged
+    TTL_CONVERT_SATURATE,  ///< Elements are converted to the destination type, saturating at its limits
+    TTL_CONVERT_AFFINE,    ///< Elements are multiplied by scale, offset added, rounded then saturated
+} TTL_conversion_kind_t;
+
+/**
+ * @brief Description of the conversion of elements from the source to the destination of a transfer.
+ *
+ * The typed converting imports, exports and pipelining schemes set src_type and dst_type from
+ * the tensors passed to them, calls of the _base functions must set them.
+ *
+ * Affine conversions are calculated in float, so are exact only for values of up to 24 bits.
+ */
+typedef struct {
+    TTL_conversion_kind_t kind;   ///< How each element is converted
+    TTL_element_type_t src_type;  ///< The type of the elements read
+    TTL_element_type_t dst_type;  ///< The type of the elements written
+    float scale;                  ///< The multiplier of an affine conversion
+    float offset;                 ///< The offset of an affine conversion, added after scaling
+} TTL_conversion_t;
+
+/**
+ * @brief Create a conversion that copies elements unchanged.
+ *
+ * Most operations with an empty conversion are ordinary transfers.
+ */
+static inline TTL_conversion_t TTL_create_empty_conversion(__TTL_NO_PARAMETERS) {
+    const TTL_conversion_t res = { TTL_CONVERT_NONE, TTL_ELEMENT_UCHAR, TTL_ELEMENT_UCHAR, 1.0f, 0.0f };
+    return res;
+}
+
+/**
+ * @brief Return true if conversion copies elements unchanged
+ */
+static inline bool TTL_conversion_empty(const TTL_conversion_t conversion) {
+    return conversion.kind == TTL_CONVERT_NONE;
+}
+
+/**
+ * @brief Create a conversion that widens or narrows elements to the destination type.
+ *
+ * Values outside of the range of the destination type are saturated to its limits.
+ */
+static inline TTL_conversion_t TTL_create_conversion(__TTL_NO_PARAMETERS) {
+    TTL_conversion_t res = TTL_create_empty_conversion();
+    res.kind = TTL_CONVERT_SATURATE;
+    return res;
+}
+
+/**
+ * @brief Create a conversion that quantises elements.
+ *
+ * Each element x is written as round(x / scale) + zero_point, saturated to the destination type.
+ *
+ * @param scale The value of one step of the quantised type
+ * @param zero_point The quantised value of 0
+ */
+static inline TTL_conversion_t TTL_create_quantisation(const float scale, const int zero_point) {
+    TTL_conversion_t res = TTL_create_empty_conversion();
+    res.kind = TTL_CONVERT_AFFINE;
+    res.scale = 1.0f / scale;
+    res.offset = (float)zero_point;
+    return res;
+}
+
+/**
+ * @brief Create a conversion that dequantises elements.
+ *
+ * Each element q is written as round((q - zero_point) * scale), saturated to the destination type.
+ * The same scale and zero_point as TTL_create_quantisation reverse its conversion.
+ *
+ * @param scale The value of one step of the quantised type
+ * @param zero_point The quantised value of 0
+ */
+static inline TTL_conversion_t TTL_create_dequantisation(const float scale, const int zero_point) {
+    TTL_conversion_t res = TTL_create_empty_conversion();
+    res.kind = TTL_CONVERT_AFFINE;
+    res.scale = scale;
+    res.offset = -(float)zero_point * scale;
+    return res;
+}
+
 /******************************************************
  * OVERLAP
  *****************************************************/
@@ -225,3 +430,83 @@ TTL_create_overlap(const TTL_overlap_dim_t width, const TTL_overlap_dim_t height
 static inline TTL_overlap_t __attribute__((overloadable)) TTL_create_overlap(const TTL_overlap_dim_t width) {
     return TTL_create_overlap(width, 0, 0);
 }
+
+/******************************************************
+ * BOUNDARY
+ *****************************************************/
+
+/**
+ * @brief How the elements of a tile that lie outside of its tensor are filled on import.
+ *
+ * For a line abcdefgh with three elements outside of each end, the modes give
+ * - TTL_BOUNDARY_CONSTANT  000|abcdefgh|000
+ * - TTL_BOUNDARY_REPLICATE aaa|abcdefgh|hhh
+ * - TTL_BOUNDARY_MIRROR    dcb|abcdefgh|gfe
+ */
+typedef enum {
+    TTL_BOUNDARY_CONSTANT,   ///< Elements outside are a constant value, zero unless given
+    TTL_BOUNDARY_REPLICATE,  ///< Elements outside repeat the nearest element at the edge (clamp to edge)
+    TTL_BOUNDARY_MIRROR,     ///< Elements outside reflect those inside, without repeating the edge element
+} TTL_boundary_mode_t;
+
+/**
+ * @brief Description of the values of the elements outside of a tensor.
+ *
+ * The value of a TTL_BOUNDARY_CONSTANT boundary is written with the element type of the internal
+ * tensor, so for a converting import it is the converted value.
+ */
+typedef struct {
+    TTL_boundary_mode_t mode;  ///< How the elements outside of the tensor are filled
+    long value;                ///< The value of the elements outside of the tensor for TTL_BOUNDARY_CONSTANT
+} TTL_boundary_t;
+
+/**
+ * @brief Create a boundary of the given mode
+ *
+ * @param mode How the elements outside of the tensor are filled, a constant boundary is zero.
+ */
+static inline TTL_boundary_t __attribute__((overloadable)) TTL_create_boundary(const TTL_boundary_mode_t mode) {
+    const TTL_boundary_t res = { mode, 0 };
+    return res;
+}
+
+/**
+ * @brief Create a boundary of zeros, the boundary of tiles unless another is given
+ */
+static inline TTL_boundary_t __attribute__((overloadable)) TTL_create_boundary(__TTL_NO_PARAMETERS) {
+    return TTL_create_boundary(TTL_BOUNDARY_CONSTANT);
+}
+
+/**
+ * @brief Create a boundary whose elements are all value
+ *
+ * @param value The value of the elements outside of the tensor
+ */
+static inline TTL_boundary_t TTL_create_constant_boundary(const long value) {
+    TTL_boundary_t res = TTL_create_boundary(TTL_BOUNDARY_CONSTANT);
+    res.value = value;
+    return res;
+}
+
+/**
+ * @brief Return the element of a dimension of size elements that position outside of it takes its value from
+ *
+ * @param boundary A TTL_BOUNDARY_REPLICATE or TTL_BOUNDARY_MIRROR boundary
+ * @param position The position, which may be outside of [0, size)
+ * @param size The size of the dimension, which must not be zero
+ */
+static inline TTL_offset_dim_t TTL_boundary_source(const TTL_boundary_t boundary, TTL_offset_dim_t position,
+                                                   const TTL_dim_t size) {
+    const TTL_offset_dim_t last = (TTL_offset_dim_t)size - 1;
+
+    if ((boundary.mode == TTL_BOUNDARY_REPLICATE) || (last == 0))
+        return position < 0 ? 0 : position > last ? last : position;
+
+    // Reflections repeat every 2 * last elements.
+    const TTL_offset_dim_t period = 2 * last;
+
+    position %= period;
+    if (position < 0) position += period;
+
+    return position > last ? period - position : position;
+}
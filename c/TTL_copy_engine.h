@@ -0,0 +1,904 @@
+/*
+ * TTL_copy_engine.h
+ *
+ * Copyright (c) 2023 Mobileye
+ *
+ * Licensed under the Apache License, Version 2.0 (the License);
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+/**
+ * @file
+ *
+ * Background copy engine for the C target, included when TTL_COPY_ENGINE is defined.
+ *
+ * Without the engine async_work_group_copy_3D3D completes the copy before returning,
+ * so the pipelining schemes never overlap a transfer with compute on the host. With
+ * the engine each copy is queued as a descriptor to one of TTL_COPY_ENGINE_CHANNELS
+ * channels, each of which is served by its own worker thread, and event_t is a handle
+ * to a completion record that wait_group_events blocks on.
+ *
+ * Imports and exports are issued to the channels in TTL_COPY_ENGINE_IMPORT_CHANNELS and
+ * TTL_COPY_ENGINE_EXPORT_CHANNELS respectively, so by default an import is never queued
+ * behind a large export. Where the two share a channel imports are started first if
+ * TTL_COPY_ENGINE_IMPORT_PRIORITY is non-zero.
+ *
+ * A copy is not started while a copy issued before it, on any channel, is outstanding
+ * and writes memory the later copy reads or writes, or reads memory the later copy
+ * writes. The simplex scheme relies on this when it exports from and then imports into
+ * the same buffer in a single step.
+ *
+ * The copies of a TTL_submit_batch are all queued before the workers are woken, so
+ * they are started together much as a DMA engine would follow a descriptor chain.
+ *
+ * Defining TTL_DMA_MODEL delays the completion of each copy to model the timing of
+ * a DMA engine, see TTL_dma_model.h.
+ *
+ * Programs using the engine must be compiled and linked with -pthread.
+ */
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+/**
+ * @def TTL_COPY_ENGINE_CHANNELS
+ *
+ * @brief The number of channels, each has a worker thread. At most 8 so that the
+ * channels used by an event fit the event's channel mask.
+ */
+#ifndef TTL_COPY_ENGINE_CHANNELS
+#define TTL_COPY_ENGINE_CHANNELS 2
+#endif
+
+#if (TTL_COPY_ENGINE_CHANNELS < 1) || (TTL_COPY_ENGINE_CHANNELS > 8)
+#error "TTL_COPY_ENGINE_CHANNELS must be between 1 and 8"
+#endif
+
+/**
+ * @def TTL_COPY_ENGINE_IMPORT_CHANNELS
+ *
+ * @brief Mask of the channels imports are issued to.
+ *
+ * Each import goes to the least busy channel in the mask. Channels that do not exist
+ * are ignored and an empty mask selects channel 0.
+ */
+#ifndef TTL_COPY_ENGINE_IMPORT_CHANNELS
+#define TTL_COPY_ENGINE_IMPORT_CHANNELS 0x01
+#endif
+
+/**
+ * @def TTL_COPY_ENGINE_EXPORT_CHANNELS
+ *
+ * @brief Mask of the channels exports are issued to, as TTL_COPY_ENGINE_IMPORT_CHANNELS
+ */
+#ifndef TTL_COPY_ENGINE_EXPORT_CHANNELS
+#define TTL_COPY_ENGINE_EXPORT_CHANNELS 0x02
+#endif
+
+/**
+ * @def TTL_COPY_ENGINE_IMPORT_PRIORITY
+ *
+ * @brief If non-zero a channel starts queued imports before queued exports.
+ */
+#ifndef TTL_COPY_ENGINE_IMPORT_PRIORITY
+#define TTL_COPY_ENGINE_IMPORT_PRIORITY 1
+#endif
+
+/**
+ * @def TTL_COPY_ENGINE_QUEUE_DEPTH
+ *
+ * @brief The number of copies, across all channels, that can be outstanding before
+ * issuing a further copy blocks.
+ */
+#ifndef TTL_COPY_ENGINE_QUEUE_DEPTH
+#define TTL_COPY_ENGINE_QUEUE_DEPTH 64
+#endif
+
+/**
+ * @def TTL_COPY_ENGINE_EVENTS
+ *
+ * @brief The number of events that can be in use at the same time.
+ *
+ * If every event is in use a copy that requires a new event waits for the queue to
+ * drain and is then performed synchronously, returning an empty event.
+ */
+#ifndef TTL_COPY_ENGINE_EVENTS
+#define TTL_COPY_ENGINE_EVENTS 64
+#endif
+
+/**
+ * @brief The completion record that an event_t points to.
+ *
+ * channels must remain the first member, __TTL_dump_event reads the event as a pointer
+ * to a mask of channels.
+ */
+struct __TTL_copy_event {
+    unsigned char channels;  ///< Mask of the channels the outstanding copies were issued to
+    unsigned int pending;    ///< The number of copies issued against the event that have not completed
+    bool in_use;             ///< The record has been handed out and not yet released by wait_group_events
+};
+
+/**
+ * @brief Description of a single 3D copy, as passed to async_work_group_copy_3D3D
+ */
+typedef struct {
+    void *dst;                       ///< Base address of the destination
+    const void *src;                 ///< Base address of the source
+    size_t num_bytes_per_element;    ///< Size of each element in bytes, of the source if converting
+    size_t num_elements_per_line;    ///< Elements copied per line
+    size_t num_lines;                ///< Lines copied per plane
+    size_t num_planes;               ///< Planes copied
+    size_t src_total_line_length;    ///< Source line spacing in elements
+    size_t src_total_plane_spacing;  ///< Source plane spacing in elements
+    size_t dst_total_line_length;    ///< Destination line spacing in elements
+    size_t dst_total_plane_spacing;  ///< Destination plane spacing in elements
+    size_t src_element_spacing;      ///< Source spacing of the elements of a line, 1 unless permuted
+    size_t dst_element_spacing;      ///< Destination spacing of the elements of a line, 1 unless permuted
+    TTL_conversion_t conversion;     ///< The conversion of each element, empty unless converting
+    bool streaming;                  ///< Write the destination with non-temporal stores where possible
+    event_t event;                   ///< The event to signal on completion
+} __TTL_copy_descriptor_t;
+
+/**
+ * @brief The direction of a copy, used to select its channels and priority.
+ */
+typedef enum {
+    __TTL_COPY_IMPORT,  ///< External to internal memory
+    __TTL_COPY_EXPORT,  ///< Internal to external memory
+} __TTL_copy_direction_t;
+
+/**
+ * @brief The lifecycle of a slot in the engine's queue.
+ */
+typedef enum {
+    __TTL_COPY_SLOT_FREE,     ///< Holds no descriptor
+    __TTL_COPY_SLOT_QUEUED,   ///< Holds a descriptor waiting for its channel
+    __TTL_COPY_SLOT_RUNNING,  ///< Holds a descriptor being executed by its channel
+} __TTL_copy_slot_state_t;
+
+/**
+ * @brief A queued descriptor and what is needed to schedule it.
+ *
+ * The extents are the first and one past the last byte the copy touches, the bytes
+ * between lines and planes are included so the hazard check is conservative.
+ */
+typedef struct {
+    __TTL_copy_descriptor_t descriptor;
+    __TTL_copy_slot_state_t state;
+    unsigned long sequence;  ///< Issue order across all channels
+    unsigned int channel;    ///< The channel executing the descriptor
+    unsigned int priority;   ///< Higher priority descriptors are started first on a channel
+    const uchar *src_begin;
+    const uchar *src_end;
+    const uchar *dst_begin;
+    const uchar *dst_end;
+} __TTL_copy_slot_t;
+
+/**
+ * @brief The state of the copy engine.
+ *
+ * All members are protected by lock.
+ */
+typedef struct {
+    pthread_mutex_t lock;
+    pthread_cond_t changed;  ///< Broadcast when a descriptor is queued or completes
+
+    __TTL_copy_slot_t slots[TTL_COPY_ENGINE_QUEUE_DEPTH];  ///< Outstanding descriptors, in no particular order
+    unsigned int count;                                    ///< Number of slots that are not free
+    unsigned long next_sequence;                           ///< Sequence number of the next descriptor issued
+    unsigned int batches;                                  ///< Number of batches being submitted
+
+    struct __TTL_copy_event events[TTL_COPY_ENGINE_EVENTS];  ///< Pool of completion records
+
+    bool running;  ///< False if a worker could not be started, in which case all copies are synchronous
+} __TTL_copy_engine_t;
+
+static inline void __TTL_copy_descriptor_execute(const __TTL_copy_descriptor_t *const descriptor) {
+    if (!TTL_conversion_empty(descriptor->conversion)) {
+        __TTL_convert_3D3D(descriptor->dst,
+                           descriptor->src,
+                           descriptor->conversion,
+                           descriptor->num_elements_per_line,
+                           descriptor->num_lines,
+                           descriptor->num_planes,
+                           descriptor->src_total_line_length,
+                           descriptor->src_total_plane_spacing,
+                           descriptor->dst_total_line_length,
+                           descriptor->dst_total_plane_spacing);
+        return;
+    }
+
+    if ((descriptor->src_element_spacing != 1) || (descriptor->dst_element_spacing != 1)) {
+        __TTL_copy_permuted_3D3D(descriptor->dst,
+                                 descriptor->src,
+                                 descriptor->num_bytes_per_element,
+                                 descriptor->num_elements_per_line,
+                                 descriptor->num_lines,
+                                 descriptor->num_planes,
+                                 descriptor->src_element_spacing,
+                                 descriptor->src_total_line_length,
+                                 descriptor->src_total_plane_spacing,
+                                 descriptor->dst_element_spacing,
+                                 descriptor->dst_total_line_length,
+                                 descriptor->dst_total_plane_spacing);
+        return;
+    }
+
+    __TTL_copy_3D3D(descriptor->dst,
+                    descriptor->src,
+                    descriptor->num_bytes_per_element,
+                    descriptor->num_elements_per_line,
+                    descriptor->num_lines,
+                    descriptor->num_planes,
+                    descriptor->src_total_line_length,
+                    descriptor->src_total_plane_spacing,
+                    descriptor->dst_total_line_length,
+                    descriptor->dst_total_plane_spacing,
+                    descriptor->streaming);
+}
+
+#ifdef TTL_DMA_MODEL
+#include "TTL_dma_model.h"
+#endif
+
+/**
+ * @brief Return the number of bytes from the first to one past the last byte of a 3D region.
+ */
+static inline size_t __TTL_copy_extent(const __TTL_copy_descriptor_t *const descriptor, size_t num_bytes_per_element,
+                                       size_t element_spacing, size_t total_line_length, size_t total_plane_spacing) {
+    if ((descriptor->num_elements_per_line == 0) || (descriptor->num_lines == 0) || (descriptor->num_planes == 0))
+        return 0;
+
+    return (((descriptor->num_planes - 1) * total_plane_spacing) + ((descriptor->num_lines - 1) * total_line_length) +
+            ((descriptor->num_elements_per_line - 1) * element_spacing) + 1) *
+           num_bytes_per_element;
+}
+
+static inline bool __TTL_copy_ranges_overlap(const uchar *const a_begin, const uchar *const a_end,
+                                             const uchar *const b_begin, const uchar *const b_end) {
+    return (a_begin < b_end) && (b_begin < a_end);
+}
+
+/**
+ * @brief Return true if earlier must complete before later can start.
+ */
+static inline bool __TTL_copy_slot_hazard(const __TTL_copy_slot_t *const earlier, const __TTL_copy_slot_t *const later) {
+    return __TTL_copy_ranges_overlap(earlier->dst_begin, earlier->dst_end, later->src_begin, later->src_end) ||
+           __TTL_copy_ranges_overlap(earlier->dst_begin, earlier->dst_end, later->dst_begin, later->dst_end) ||
+           __TTL_copy_ranges_overlap(earlier->src_begin, earlier->src_end, later->dst_begin, later->dst_end);
+}
+
+/**
+ * @brief Return the next descriptor channel should execute, or NULL if none can start.
+ *
+ * The highest priority queued descriptor for the channel that has no hazard with an
+ * earlier outstanding descriptor is chosen, the earliest issued if several qualify.
+ *
+ * Must be called with the engine lock held.
+ */
+static inline __TTL_copy_slot_t *__TTL_copy_engine_next(__TTL_copy_engine_t *const engine,
+                                                        const unsigned int channel) {
+    __TTL_copy_slot_t *next = NULL;
+
+    for (unsigned int i = 0; i < TTL_COPY_ENGINE_QUEUE_DEPTH; i++) {
+        __TTL_copy_slot_t *const candidate = &engine->slots[i];
+
+        if ((candidate->state != __TTL_COPY_SLOT_QUEUED) || (candidate->channel != channel)) continue;
+
+        if (next && ((candidate->priority < next->priority) ||
+                     ((candidate->priority == next->priority) && (candidate->sequence > next->sequence))))
+            continue;
+
+        bool blocked = false;
+
+        for (unsigned int j = 0; (j < TTL_COPY_ENGINE_QUEUE_DEPTH) && (blocked == false); j++) {
+            const __TTL_copy_slot_t *const earlier = &engine->slots[j];
+
+            blocked = (earlier->state != __TTL_COPY_SLOT_FREE) && (earlier->sequence < candidate->sequence) &&
+                      __TTL_copy_slot_hazard(earlier, candidate);
+        }
+
+        if (blocked == false) next = candidate;
+    }
+
+    return next;
+}
+
+/**
+ * @brief The copy engine.
+ *
+ * As with the rest of TTL the engine is static, so each translation unit including
+ * TTL has its own engine.
+ */
+static __TTL_copy_engine_t __TTL_copy_engine_state;
+static pthread_once_t __TTL_copy_engine_once = PTHREAD_ONCE_INIT;
+
+/**
+ * @brief The worker thread for a channel, arg is the channel number.
+ *
+ * A descriptor keeps its slot while it executes so that queue space and event
+ * completion are released together, and so later descriptors see the hazard.
+ */
+static void *__TTL_copy_engine_worker(void *const arg) {
+    __TTL_copy_engine_t *const engine = &__TTL_copy_engine_state;
+    const unsigned int channel = (unsigned int)(size_t)arg;
+
+    pthread_mutex_lock(&engine->lock);
+
+    for (;;) {
+        __TTL_copy_slot_t *const slot = __TTL_copy_engine_next(engine, channel);
+
+        if (slot == NULL) {
+            pthread_cond_wait(&engine->changed, &engine->lock);
+            continue;
+        }
+
+        slot->state = __TTL_COPY_SLOT_RUNNING;
+        const __TTL_copy_descriptor_t descriptor = slot->descriptor;
+
+        pthread_mutex_unlock(&engine->lock);
+#ifdef TTL_DMA_MODEL
+        __TTL_dma_model_execute(channel, &descriptor);
+#else
+        __TTL_copy_descriptor_execute(&descriptor);
+#endif
+        pthread_mutex_lock(&engine->lock);
+
+        slot->state = __TTL_COPY_SLOT_FREE;
+        engine->count--;
+
+        if (--descriptor.event->pending == 0) descriptor.event->channels = 0;
+
+        pthread_cond_broadcast(&engine->changed);
+    }
+
+    return NULL;
+}
+
+static void __TTL_copy_engine_start(void) {
+    __TTL_copy_engine_t *const engine = &__TTL_copy_engine_state;
+
+    pthread_mutex_init(&engine->lock, NULL);
+    pthread_cond_init(&engine->changed, NULL);
+
+    // Workers that did start never find work if a later one fails, as every copy is then synchronous.
+    engine->running = true;
+
+    for (unsigned int channel = 0; (channel < TTL_COPY_ENGINE_CHANNELS) && engine->running; channel++) {
+        pthread_t worker;
+
+        engine->running = pthread_create(&worker, NULL, __TTL_copy_engine_worker, (void *)(size_t)channel) == 0;
+
+        if (engine->running) pthread_detach(worker);
+    }
+}
+
+/**
+ * @brief Return the copy engine, starting it on first use.
+ */
+static inline __TTL_copy_engine_t *__TTL_copy_engine(__TTL_NO_PARAMETERS) {
+    pthread_once(&__TTL_copy_engine_once, __TTL_copy_engine_start);
+
+    return &__TTL_copy_engine_state;
+}
+
+/**
+ * @brief Take an unused event from the pool, or return NULL if all are in use.
+ *
+ * Must be called with the engine lock held.
+ */
+static inline event_t __TTL_copy_engine_get_event(__TTL_copy_engine_t *const engine) {
+    for (unsigned int i = 0; i < TTL_COPY_ENGINE_EVENTS; i++) {
+        if (engine->events[i].in_use == false) {
+            engine->events[i].in_use = true;
+            engine->events[i].pending = 0;
+            engine->events[i].channels = 0;
+            return &engine->events[i];
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Return the least busy channel for a direction.
+ *
+ * Must be called with the engine lock held.
+ */
+static inline unsigned int __TTL_copy_engine_channel(const __TTL_copy_engine_t *const engine,
+                                                     const __TTL_copy_direction_t direction) {
+    const unsigned int mask = (direction == __TTL_COPY_IMPORT ? TTL_COPY_ENGINE_IMPORT_CHANNELS
+                                                              : TTL_COPY_ENGINE_EXPORT_CHANNELS) &
+                              ((1u << TTL_COPY_ENGINE_CHANNELS) - 1);
+    unsigned int busy[TTL_COPY_ENGINE_CHANNELS] = { 0 };
+    unsigned int channel = 0;
+
+    if (mask == 0) return 0;
+
+    for (unsigned int i = 0; i < TTL_COPY_ENGINE_QUEUE_DEPTH; i++) {
+        if (engine->slots[i].state != __TTL_COPY_SLOT_FREE) busy[engine->slots[i].channel]++;
+    }
+
+    while ((mask & (1u << channel)) == 0) channel++;
+
+    for (unsigned int i = channel + 1; i < TTL_COPY_ENGINE_CHANNELS; i++) {
+        if ((mask & (1u << i)) && (busy[i] < busy[channel])) channel = i;
+    }
+
+    return channel;
+}
+
+/**
+ * @brief Queue a descriptor to the engine.
+ *
+ * @param descriptor The copy to perform, its event member is ignored.
+ * @param direction Whether the copy is an import or an export.
+ * @param event The event to associate the copy with. If empty a new event is taken from the pool.
+ *
+ * @return The event associated with the copy.
+ */
+static inline event_t __TTL_copy_engine_submit(const __TTL_copy_descriptor_t *const descriptor,
+                                               const __TTL_copy_direction_t direction, event_t event) {
+    __TTL_copy_engine_t *const engine = __TTL_copy_engine();
+
+    if (engine->running == false) {
+        __TTL_copy_descriptor_execute(descriptor);
+        return event;
+    }
+
+    pthread_mutex_lock(&engine->lock);
+
+    if (event == NULL) event = __TTL_copy_engine_get_event(engine);
+
+    if (event == NULL) {
+        // No event can be returned, so complete everything issued so far (to respect
+        // any hazards) and then perform this copy before returning.
+        pthread_cond_broadcast(&engine->changed);
+        while (engine->count != 0) pthread_cond_wait(&engine->changed, &engine->lock);
+        pthread_mutex_unlock(&engine->lock);
+
+        __TTL_copy_descriptor_execute(descriptor);
+        return NULL;
+    }
+
+    if (engine->count == TTL_COPY_ENGINE_QUEUE_DEPTH) pthread_cond_broadcast(&engine->changed);
+    while (engine->count == TTL_COPY_ENGINE_QUEUE_DEPTH) pthread_cond_wait(&engine->changed, &engine->lock);
+
+    __TTL_copy_slot_t *slot = engine->slots;
+    while (slot->state != __TTL_COPY_SLOT_FREE) slot++;
+
+    slot->descriptor = *descriptor;
+    slot->descriptor.event = event;
+    slot->state = __TTL_COPY_SLOT_QUEUED;
+    slot->sequence = engine->next_sequence++;
+    slot->channel = __TTL_copy_engine_channel(engine, direction);
+    slot->priority = (TTL_COPY_ENGINE_IMPORT_PRIORITY && (direction == __TTL_COPY_IMPORT)) ? 1 : 0;
+    slot->src_begin = (const uchar *)descriptor->src;
+    slot->src_end = slot->src_begin + __TTL_copy_extent(descriptor,
+                                                        descriptor->num_bytes_per_element,
+                                                        descriptor->src_element_spacing,
+                                                        descriptor->src_total_line_length,
+                                                        descriptor->src_total_plane_spacing);
+    slot->dst_begin = (const uchar *)descriptor->dst;
+    slot->dst_end = slot->dst_begin + __TTL_copy_extent(descriptor,
+                                                        TTL_conversion_empty(descriptor->conversion)
+                                                            ? descriptor->num_bytes_per_element
+                                                            : TTL_element_size(descriptor->conversion.dst_type),
+                                                        descriptor->dst_element_spacing,
+                                                        descriptor->dst_total_line_length,
+                                                        descriptor->dst_total_plane_spacing);
+    engine->count++;
+
+    event->pending++;
+    event->channels |= 1 << slot->channel;
+
+    // Within a batch the workers are woken once, by __TTL_copy_engine_batch_end.
+    if (engine->batches == 0) pthread_cond_broadcast(&engine->changed);
+    pthread_mutex_unlock(&engine->lock);
+
+    return event;
+}
+
+/**
+ * @brief Hold back the wake up of the workers while the copies of a batch are queued.
+ *
+ * A worker that is already busy may still start a queued copy of the batch.
+ */
+static inline void __TTL_copy_engine_batch_begin(__TTL_NO_PARAMETERS) {
+    __TTL_copy_engine_t *const engine = __TTL_copy_engine();
+
+    pthread_mutex_lock(&engine->lock);
+    engine->batches++;
+    pthread_mutex_unlock(&engine->lock);
+}
+
+/**
+ * @brief Wake the workers to start the copies queued since __TTL_copy_engine_batch_begin.
+ */
+static inline void __TTL_copy_engine_batch_end(__TTL_NO_PARAMETERS) {
+    __TTL_copy_engine_t *const engine = __TTL_copy_engine();
+
+    pthread_mutex_lock(&engine->lock);
+    engine->batches--;
+    pthread_cond_broadcast(&engine->changed);
+    pthread_mutex_unlock(&engine->lock);
+}
+
+#define TTL_COPY_BATCH_BEGIN() __TTL_copy_engine_batch_begin()
+#define TTL_COPY_BATCH_END() __TTL_copy_engine_batch_end()
+
+/**
+ * @brief Wait for events that identify the async_work_group_copy operations to
+ * complete.
+ *
+ * @param num_events Number of events to wait for (size of event_list)
+ * @param event_list A pointer to a list of events.
+ *
+ * Once complete each event is returned to the pool and its entry in event_list is
+ * set to the empty event, so the same variable can be passed to the next copy.
+ *
+ * @see OpenCL's wait_group_events() builtin for more information.
+ */
+static inline void wait_group_events(int num_events, event_t *event_list) {
+    __TTL_copy_engine_t *const engine = __TTL_copy_engine();
+
+#ifdef TTL_DMA_MODEL
+    struct timespec wait_start;
+    struct timespec wait_end;
+
+    clock_gettime(CLOCK_MONOTONIC, &wait_start);
+#endif
+
+    pthread_mutex_lock(&engine->lock);
+
+    for (int i = 0; i < num_events; i++) {
+        const event_t event = event_list[i];
+
+        if (event == NULL) continue;
+
+        while (event->pending != 0) pthread_cond_wait(&engine->changed, &engine->lock);
+
+        event->in_use = false;
+        event_list[i] = NULL;
+    }
+
+    pthread_mutex_unlock(&engine->lock);
+
+#ifdef TTL_DMA_MODEL
+    clock_gettime(CLOCK_MONOTONIC, &wait_end);
+    __TTL_dma_model_stalled(&wait_start, &wait_end);
+#endif
+}
+
+/**
+ * @brief Return true if the copies of an event have completed, without waiting.
+ *
+ * A completed event is returned to the pool and set to the empty event, as by
+ * wait_group_events. The empty event is always complete.
+ */
+static inline bool __TTL_copy_engine_test_event(event_t *const event) {
+    __TTL_copy_engine_t *const engine = __TTL_copy_engine();
+    bool complete = true;
+
+    pthread_mutex_lock(&engine->lock);
+
+    if (*event != NULL) {
+        complete = ((*event)->pending == 0);
+
+        if (complete) {
+            (*event)->in_use = false;
+            *event = NULL;
+        }
+    }
+
+    pthread_mutex_unlock(&engine->lock);
+
+    return complete;
+}
+
+/**
+ * @brief Wait for the copies of any one of a list of events to complete.
+ *
+ * The first complete event in event_list is returned to the pool and set to the empty
+ * event, the others are left outstanding. The empty event is always complete.
+ *
+ * @return The index in event_list of the complete event, or -1 if num_events is 0.
+ */
+static inline int __TTL_copy_engine_wait_any(int num_events, event_t *event_list) {
+    __TTL_copy_engine_t *const engine = __TTL_copy_engine();
+    int complete = -1;
+
+    if (num_events <= 0) return complete;
+
+#ifdef TTL_DMA_MODEL
+    struct timespec wait_start;
+    struct timespec wait_end;
+
+    clock_gettime(CLOCK_MONOTONIC, &wait_start);
+#endif
+
+    pthread_mutex_lock(&engine->lock);
+
+    for (;;) {
+        for (int i = 0; (i < num_events) && (complete < 0); i++) {
+            if ((event_list[i] == NULL) || (event_list[i]->pending == 0)) complete = i;
+        }
+
+        if (complete >= 0) break;
+
+        pthread_cond_wait(&engine->changed, &engine->lock);
+    }
+
+    if (event_list[complete] != NULL) {
+        event_list[complete]->in_use = false;
+        event_list[complete] = NULL;
+    }
+
+    pthread_mutex_unlock(&engine->lock);
+
+#ifdef TTL_DMA_MODEL
+    clock_gettime(CLOCK_MONOTONIC, &wait_end);
+    __TTL_dma_model_stalled(&wait_start, &wait_end);
+#endif
+
+    return complete;
+}
+
+#define TTL_TEST_EVENT __TTL_copy_engine_test_event
+#define TTL_WAIT_ANY_EVENT __TTL_copy_engine_wait_any
+
+/**
+ * @brief Build a descriptor from the async_work_group_copy_3D3D parameters and queue it.
+ */
+static inline event_t __TTL_copy_engine_copy_3D3D(const __TTL_copy_direction_t direction, const bool streaming,
+                                                  void *const dst, size_t dst_offset, const void *const src,
+                                                  size_t src_offset, size_t num_bytes_per_element,
+                                                  size_t num_elements_per_line, size_t num_lines, size_t num_planes,
+                                                  size_t src_total_line_length, size_t src_total_plane_spacing,
+                                                  size_t dst_total_line_length, size_t dst_total_plane_spacing,
+                                                  event_t event) {
+    const __TTL_copy_descriptor_t descriptor = { (uchar *)dst + (dst_offset * num_bytes_per_element),
+                                                 (const uchar *)src + (src_offset * num_bytes_per_element),
+                                                 num_bytes_per_element,
+                                                 num_elements_per_line,
+                                                 num_lines,
+                                                 num_planes,
+                                                 src_total_line_length,
+                                                 src_total_plane_spacing,
+                                                 dst_total_line_length,
+                                                 dst_total_plane_spacing,
+                                                 1,
+                                                 1,
+                                                 TTL_create_empty_conversion(),
+                                                 streaming,
+                                                 NULL };
+
+    return __TTL_copy_engine_submit(&descriptor, direction, event);
+}
+
+static inline event_t __TTL_copy_engine_import_3D3D(void *const dst, size_t dst_offset, const void *const src,
+                                                    size_t src_offset, size_t num_bytes_per_element,
+                                                    size_t num_elements_per_line, size_t num_lines,
+                                                    size_t num_planes, size_t src_total_line_length,
+                                                    size_t src_total_plane_spacing, size_t dst_total_line_length,
+                                                    size_t dst_total_plane_spacing, event_t event) {
+    return __TTL_copy_engine_copy_3D3D(__TTL_COPY_IMPORT,
+                                       false,
+                                       dst,
+                                       dst_offset,
+                                       src,
+                                       src_offset,
+                                       num_bytes_per_element,
+                                       num_elements_per_line,
+                                       num_lines,
+                                       num_planes,
+                                       src_total_line_length,
+                                       src_total_plane_spacing,
+                                       dst_total_line_length,
+                                       dst_total_plane_spacing,
+                                       event);
+}
+
+static inline event_t __TTL_copy_engine_export_3D3D(void *const dst, size_t dst_offset, const void *const src,
+                                                    size_t src_offset, size_t num_bytes_per_element,
+                                                    size_t num_elements_per_line, size_t num_lines,
+                                                    size_t num_planes, size_t src_total_line_length,
+                                                    size_t src_total_plane_spacing, size_t dst_total_line_length,
+                                                    size_t dst_total_plane_spacing, event_t event) {
+    return __TTL_copy_engine_copy_3D3D(__TTL_COPY_EXPORT,
+                                       __TTL_export_streaming(num_bytes_per_element * num_elements_per_line *
+                                                              num_lines * num_planes),
+                                       dst,
+                                       dst_offset,
+                                       src,
+                                       src_offset,
+                                       num_bytes_per_element,
+                                       num_elements_per_line,
+                                       num_lines,
+                                       num_planes,
+                                       src_total_line_length,
+                                       src_total_plane_spacing,
+                                       dst_total_line_length,
+                                       dst_total_plane_spacing,
+                                       event);
+}
+
+/**
+ * @brief Queue a copy issued directly rather than through TTL_import or TTL_export.
+ *
+ * Such copies are treated as exports, they use the export channels and do not take
+ * priority, but are always written through the cache.
+ */
+static inline event_t async_work_group_copy_3D3D(void *const dst, size_t dst_offset, const void *const src,
+                                                 size_t src_offset, size_t num_bytes_per_element,
+                                                 size_t num_elements_per_line, size_t num_lines, size_t num_planes,
+                                                 size_t src_total_line_length, size_t src_total_plane_spacing,
+                                                 size_t dst_total_line_length, size_t dst_total_plane_spacing,
+                                                 event_t event) {
+    return __TTL_copy_engine_copy_3D3D(__TTL_COPY_EXPORT,
+                                       false,
+                                       dst,
+                                       dst_offset,
+                                       src,
+                                       src_offset,
+                                       num_bytes_per_element,
+                                       num_elements_per_line,
+                                       num_lines,
+                                       num_planes,
+                                       src_total_line_length,
+                                       src_total_plane_spacing,
+                                       dst_total_line_length,
+                                       dst_total_plane_spacing,
+                                       event);
+}
+
+#define TTL_IMPORT_COPY_3D3D __TTL_copy_engine_import_3D3D
+#define TTL_EXPORT_COPY_3D3D __TTL_copy_engine_export_3D3D
+
+/**
+ * @brief Queue a permuted import, @see TTL_IMPORT_PERMUTED_COPY
+ */
+static inline event_t __TTL_copy_engine_import_permuted_3D(void *const dst, const void *const src,
+                                                           size_t num_bytes_per_element, size_t num_elements_per_line,
+                                                           size_t num_lines, size_t num_planes,
+                                                           size_t src_element_spacing, size_t src_total_line_length,
+                                                           size_t src_total_plane_spacing,
+                                                           size_t dst_total_line_length,
+                                                           size_t dst_total_plane_spacing, event_t event) {
+    const __TTL_copy_descriptor_t descriptor = { dst,
+                                                 src,
+                                                 num_bytes_per_element,
+                                                 num_elements_per_line,
+                                                 num_lines,
+                                                 num_planes,
+                                                 src_total_line_length,
+                                                 src_total_plane_spacing,
+                                                 dst_total_line_length,
+                                                 dst_total_plane_spacing,
+                                                 src_element_spacing,
+                                                 1,
+                                                 TTL_create_empty_conversion(),
+                                                 false,
+                                                 NULL };
+
+    return __TTL_copy_engine_submit(&descriptor, __TTL_COPY_IMPORT, event);
+}
+
+/**
+ * @brief Queue a permuted export, @see TTL_EXPORT_PERMUTED_COPY
+ */
+static inline event_t __TTL_copy_engine_export_permuted_3D(void *const dst, const void *const src,
+                                                           size_t num_bytes_per_element, size_t num_elements_per_line,
+                                                           size_t num_lines, size_t num_planes,
+                                                           size_t src_total_line_length,
+                                                           size_t src_total_plane_spacing, size_t dst_element_spacing,
+                                                           size_t dst_total_line_length,
+                                                           size_t dst_total_plane_spacing, event_t event) {
+    const __TTL_copy_descriptor_t descriptor = { dst,
+                                                 src,
+                                                 num_bytes_per_element,
+                                                 num_elements_per_line,
+                                                 num_lines,
+                                                 num_planes,
+                                                 src_total_line_length,
+                                                 src_total_plane_spacing,
+                                                 dst_total_line_length,
+                                                 dst_total_plane_spacing,
+                                                 1,
+                                                 dst_element_spacing,
+                                                 TTL_create_empty_conversion(),
+                                                 false,
+                                                 NULL };
+
+    return __TTL_copy_engine_submit(&descriptor, __TTL_COPY_EXPORT, event);
+}
+
+#define TTL_IMPORT_PERMUTED_COPY __TTL_copy_engine_import_permuted_3D
+#define TTL_EXPORT_PERMUTED_COPY __TTL_copy_engine_export_permuted_3D
+
+/**
+ * @brief Build a descriptor for a converting copy and queue it, @see TTL_IMPORT_CONVERTED_COPY
+ *
+ * The conversion is performed by the channel's worker as it copies.
+ */
+static inline event_t __TTL_copy_engine_converted_3D(const __TTL_copy_direction_t direction, void *const dst,
+                                                     const void *const src, const TTL_conversion_t conversion,
+                                                     size_t num_elements_per_line, size_t num_lines,
+                                                     size_t num_planes, size_t src_total_line_length,
+                                                     size_t src_total_plane_spacing, size_t dst_total_line_length,
+                                                     size_t dst_total_plane_spacing, event_t event) {
+    const __TTL_copy_descriptor_t descriptor = { dst,
+                                                 src,
+                                                 TTL_element_size(conversion.src_type),
+                                                 num_elements_per_line,
+                                                 num_lines,
+                                                 num_planes,
+                                                 src_total_line_length,
+                                                 src_total_plane_spacing,
+                                                 dst_total_line_length,
+                                                 dst_total_plane_spacing,
+                                                 1,
+                                                 1,
+                                                 conversion,
+                                                 false,
+                                                 NULL };
+
+    return __TTL_copy_engine_submit(&descriptor, direction, event);
+}
+
+static inline event_t __TTL_copy_engine_import_converted_3D(void *const dst, const void *const src,
+                                                            const TTL_conversion_t conversion,
+                                                            size_t num_elements_per_line, size_t num_lines,
+                                                            size_t num_planes, size_t src_total_line_length,
+                                                            size_t src_total_plane_spacing,
+                                                            size_t dst_total_line_length,
+                                                            size_t dst_total_plane_spacing, event_t event) {
+    return __TTL_copy_engine_converted_3D(__TTL_COPY_IMPORT,
+                                          dst,
+                                          src,
+                                          conversion,
+                                          num_elements_per_line,
+                                          num_lines,
+                                          num_planes,
+                                          src_total_line_length,
+                                          src_total_plane_spacing,
+                                          dst_total_line_length,
+                                          dst_total_plane_spacing,
+                                          event);
+}
+
+static inline event_t __TTL_copy_engine_export_converted_3D(void *const dst, const void *const src,
+                                                            const TTL_conversion_t conversion,
+                                                            size_t num_elements_per_line, size_t num_lines,
+                                                            size_t num_planes, size_t src_total_line_length,
+                                                            size_t src_total_plane_spacing,
+                                                            size_t dst_total_line_length,
+                                                            size_t dst_total_plane_spacing, event_t event) {
+    return __TTL_copy_engine_converted_3D(__TTL_COPY_EXPORT,
+                                          dst,
+                                          src,
+                                          conversion,
+                                          num_elements_per_line,
+                                          num_lines,
+                                          num_planes,
+                                          src_total_line_length,
+                                          src_total_plane_spacing,
+                                          dst_total_line_length,
+                                          dst_total_plane_spacing,
+                                          event);
+}
+
+#define TTL_IMPORT_CONVERTED_COPY __TTL_copy_engine_import_converted_3D
+#define TTL_EXPORT_CONVERTED_COPY __TTL_copy_engine_export_converted_3D
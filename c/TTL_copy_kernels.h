@@ -0,0 +1,442 @@
+/*
+ * TTL_copy_kernels.h
+ *
+ * Copyright (c) 2023 Mobileye
+ *
+ * Licensed under the Apache License, Version 2.0 (the License);
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+/**
+ * @file
+ *
+ * Strided row copy kernels used by the C target's __TTL_copy_3D3D.
+ *
+ * Tiles are often only a few elements wide, in which case calling memcpy for every
+ * line costs more than the copy. Rows of up to 127 bytes are instead copied by kernels
+ * specialised for a size class: a row of chunk to 2 * chunk - 1 bytes is copied with
+ * two, possibly overlapping, chunk sized moves from its start and end. The element
+ * size does not matter once the row length is known in bytes.
+ *
+ * The chunks are GCC/clang vector types so the same source builds for any host. On
+ * x86 the generic kernels use SSE2 and AVX2 and AVX-512 variants of the wider classes
+ * are selected at runtime when the CPU supports them.
+ */
+
+#include <stddef.h>
+#include <string.h>
+
+/**
+ * @brief Signature of a kernel that copies num_planes * num_lines rows of row_bytes bytes.
+ *
+ * The line and plane spacings are in bytes.
+ */
+typedef void (*__TTL_copy_rows_kernel_t)(uchar *const dst, const uchar *const src, const size_t row_bytes,
+                                         const size_t num_lines, const size_t num_planes, const size_t src_line_bytes,
+                                         const size_t src_plane_bytes, const size_t dst_line_bytes,
+                                         const size_t dst_plane_bytes);
+
+/**
+ * @brief Copy rows of any length with a call to memcpy per row.
+ */
+static inline void __TTL_copy_rows_memcpy(uchar *const dst, const uchar *const src, const size_t row_bytes,
+                                          const size_t num_lines, const size_t num_planes,
+                                          const size_t src_line_bytes, const size_t src_plane_bytes,
+                                          const size_t dst_line_bytes, const size_t dst_plane_bytes) {
+    for (size_t plane = 0; plane < num_planes; plane++) {
+        const uchar *src_ptr = src + (src_plane_bytes * plane);
+        uchar *dst_ptr = dst + (dst_plane_bytes * plane);
+
+        for (size_t line = 0; line < num_lines; line++) {
+            memcpy(dst_ptr, src_ptr, row_bytes);
+
+            src_ptr += src_line_bytes;
+            dst_ptr += dst_line_bytes;
+        }
+    }
+}
+
+/**
+ * @def __TTL_create_copy_rows_kernel
+ *
+ * @brief Create __TTL_copy_rows_<chunk_bytes><suffix>, a kernel for rows of chunk_bytes to
+ * 2 * chunk_bytes - 1 bytes.
+ *
+ * Both chunks are loaded before either is stored, the source and destination of a
+ * transfer never overlap.
+ */
+#define __TTL_create_copy_rows_kernel(chunk_bytes, suffix, attributes)                                                \
+    static inline attributes void __TTL_copy_rows_##chunk_bytes##suffix(uchar *const dst,                             \
+                                                                        const uchar *const src,                       \
+                                                                        const size_t row_bytes,                       \
+                                                                        const size_t num_lines,                       \
+                                                                        const size_t num_planes,                      \
+                                                                        const size_t src_line_bytes,                  \
+                                                                        const size_t src_plane_bytes,                 \
+                                                                        const size_t dst_line_bytes,                  \
+                                                                        const size_t dst_plane_bytes) {               \
+        typedef uchar __attribute__((vector_size(chunk_bytes), aligned(1), may_alias)) chunk_t;                       \
+        const size_t tail = row_bytes - chunk_bytes;                                                                  \
+                                                                                                                      \
+        for (size_t plane = 0; plane < num_planes; plane++) {                                                         \
+            const uchar *src_ptr = src + (src_plane_bytes * plane);                                                   \
+            uchar *dst_ptr = dst + (dst_plane_bytes * plane);                                                         \
+                                                                                                                      \
+            for (size_t line = 0; line < num_lines; line++) {                                                         \
+                const chunk_t head_chunk = *(const chunk_t *)src_ptr;                                                 \
+                const chunk_t tail_chunk = *(const chunk_t *)(src_ptr + tail);                                        \
+                                                                                                                      \
+                *(chunk_t *)dst_ptr = head_chunk;                                                                     \
+                *(chunk_t *)(dst_ptr + tail) = tail_chunk;                                                            \
+                                                                                                                      \
+                src_ptr += src_line_bytes;                                                                            \
+                dst_ptr += dst_line_bytes;                                                                            \
+            }                                                                                                         \
+        }                                                                                                             \
+    }
+
+__TTL_create_copy_rows_kernel(1, , );
+__TTL_create_copy_rows_kernel(2, , );
+__TTL_create_copy_rows_kernel(4, , );
+__TTL_create_copy_rows_kernel(8, , );
+__TTL_create_copy_rows_kernel(16, , );
+__TTL_create_copy_rows_kernel(32, , );
+__TTL_create_copy_rows_kernel(64, , );
+
+#if defined(__x86_64__) || defined(__i386__)
+#define __TTL_COPY_KERNELS_DISPATCH
+
+__TTL_create_copy_rows_kernel(32, _avx2, __attribute__((target("avx2"))));
+__TTL_create_copy_rows_kernel(64, _avx2, __attribute__((target("avx2"))));
+__TTL_create_copy_rows_kernel(64, _avx512, __attribute__((target("avx512f"))));
+#endif
+
+/**
+ * @brief Return the fastest kernel for rows of row_bytes bytes on this CPU.
+ */
+static inline __TTL_copy_rows_kernel_t __TTL_copy_rows_kernel(const size_t row_bytes) {
+    if ((row_bytes == 0) || (row_bytes >= 128)) return __TTL_copy_rows_memcpy;
+
+    if (row_bytes >= 64) {
+#ifdef __TTL_COPY_KERNELS_DISPATCH
+        if (__builtin_cpu_supports("avx512f")) return __TTL_copy_rows_64_avx512;
+        if (__builtin_cpu_supports("avx2")) return __TTL_copy_rows_64_avx2;
+#endif
+        return __TTL_copy_rows_64;
+    }
+
+    if (row_bytes >= 32) {
+#ifdef __TTL_COPY_KERNELS_DISPATCH
+        if (__builtin_cpu_supports("avx2")) return __TTL_copy_rows_32_avx2;
+#endif
+        return __TTL_copy_rows_32;
+    }
+
+    if (row_bytes >= 16) return __TTL_copy_rows_16;
+    if (row_bytes >= 8) return __TTL_copy_rows_8;
+    if (row_bytes >= 4) return __TTL_copy_rows_4;
+    if (row_bytes >= 2) return __TTL_copy_rows_2;
+
+    return __TTL_copy_rows_1;
+}
+
+/*
+ * Non-temporal stores, used by __TTL_copy_rows_streaming when the compiler provides them.
+ */
+#if defined(__has_builtin)
+#if __has_builtin(__builtin_nontemporal_store)
+#define __TTL_stream_store(address, value) __builtin_nontemporal_store(value, address)
+#endif
+#endif
+
+#if !defined(__TTL_stream_store) && defined(__GNUC__) && defined(__SSE2__)
+typedef long long __TTL_stream_v2di_t __attribute__((vector_size(16)));
+#define __TTL_stream_store(address, value) \
+    __builtin_ia32_movntdq((__TTL_stream_v2di_t *)(address), (__TTL_stream_v2di_t)(value))
+#endif
+
+#ifdef __TTL_stream_store
+/**
+ * @def TTL_STREAMING_MIN_ROW_BYTES
+ *
+ * @brief Rows shorter than this are written through the cache even when streaming is
+ * requested, as they fill too little of a write combining buffer to benefit.
+ */
+#ifndef TTL_STREAMING_MIN_ROW_BYTES
+#define TTL_STREAMING_MIN_ROW_BYTES 64
+#endif
+
+/**
+ * @brief Copy rows of any length writing the destination with non-temporal stores.
+ *
+ * The destination is written in aligned 16 byte chunks that bypass the cache, with
+ * any unaligned bytes at the start and end of each row written normally. The stores
+ * are fenced before returning so that they are visible to whoever is signalled next.
+ */
+static inline void __TTL_copy_rows_streaming(uchar *const dst, const uchar *const src, const size_t row_bytes,
+                                             const size_t num_lines, const size_t num_planes,
+                                             const size_t src_line_bytes, const size_t src_plane_bytes,
+                                             const size_t dst_line_bytes, const size_t dst_plane_bytes) {
+    typedef uchar __attribute__((vector_size(16), aligned(1), may_alias)) src_chunk_t;
+    typedef uchar __attribute__((vector_size(16), may_alias)) dst_chunk_t;
+
+    for (size_t plane = 0; plane < num_planes; plane++) {
+        const uchar *src_ptr = src + (src_plane_bytes * plane);
+        uchar *dst_ptr = dst + (dst_plane_bytes * plane);
+
+        for (size_t line = 0; line < num_lines; line++) {
+            size_t offset = (sizeof(dst_chunk_t) - ((size_t)dst_ptr % sizeof(dst_chunk_t))) % sizeof(dst_chunk_t);
+
+            if (offset > row_bytes) offset = row_bytes;
+
+            memcpy(dst_ptr, src_ptr, offset);
+
+            for (; (offset + sizeof(dst_chunk_t)) <= row_bytes; offset += sizeof(dst_chunk_t)) {
+                __TTL_stream_store((dst_chunk_t *)(dst_ptr + offset), (dst_chunk_t)(*(const src_chunk_t *)(src_ptr + offset)));
+            }
+
+            memcpy(dst_ptr + offset, src_ptr + offset, row_bytes - offset);
+
+            src_ptr += src_line_bytes;
+            dst_ptr += dst_line_bytes;
+        }
+    }
+
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_sfence();
+#else
+    __sync_synchronize();
+#endif
+}
+#endif
+
+/**
+ * @brief Return the kernel for rows of row_bytes bytes when the destination should not be cached.
+ *
+ * Falls back to __TTL_copy_rows_kernel if non-temporal stores are not available or
+ * the rows are shorter than TTL_STREAMING_MIN_ROW_BYTES.
+ */
+static inline __TTL_copy_rows_kernel_t __TTL_copy_rows_streaming_kernel(const size_t row_bytes) {
+#ifdef __TTL_stream_store
+    if (row_bytes >= TTL_STREAMING_MIN_ROW_BYTES) return __TTL_copy_rows_streaming;
+#endif
+
+    return __TTL_copy_rows_kernel(row_bytes);
+}
+
+/*
+ * Permuted copies, where the elements of a line are not contiguous in the source or the
+ * destination, for example a transposing import.
+ */
+
+/**
+ * @def TTL_PERMUTED_COPY_BLOCK
+ *
+ * @brief Elements along each side of the square blocks a permuted copy is performed in.
+ *
+ * Each block touches this many lines of both the source and the destination, which
+ * should fit in the L1 cache together.
+ */
+#ifndef TTL_PERMUTED_COPY_BLOCK
+#define TTL_PERMUTED_COPY_BLOCK 16
+#endif
+
+/**
+ * @brief Signature of a kernel that copies a width by num_lines block of elements.
+ *
+ * All of the spacings are in bytes.
+ */
+typedef void (*__TTL_copy_block_kernel_t)(uchar *const dst, const uchar *const src, const size_t num_bytes_per_element,
+                                          const size_t width, const size_t num_lines, const size_t src_element_bytes,
+                                          const size_t src_line_bytes, const size_t dst_element_bytes,
+                                          const size_t dst_line_bytes);
+
+/**
+ * @brief Copy a block of elements of any size with a call to memcpy per element.
+ */
+static inline void __TTL_copy_block_memcpy(uchar *const dst, const uchar *const src, const size_t num_bytes_per_element,
+                                           const size_t width, const size_t num_lines, const size_t src_element_bytes,
+                                           const size_t src_line_bytes, const size_t dst_element_bytes,
+                                           const size_t dst_line_bytes) {
+    for (size_t line = 0; line < num_lines; line++) {
+        for (size_t x = 0; x < width; x++) {
+            memcpy(dst + (line * dst_line_bytes) + (x * dst_element_bytes),
+                   src + (line * src_line_bytes) + (x * src_element_bytes),
+                   num_bytes_per_element);
+        }
+    }
+}
+
+/**
+ * @def __TTL_create_copy_block_kernel
+ *
+ * @brief Create __TTL_copy_block_<element_bytes>, a kernel for blocks of element_bytes sized elements.
+ */
+#define __TTL_create_copy_block_kernel(element_bytes)                                                               \
+    static inline void __TTL_copy_block_##element_bytes(uchar *const dst,                                           \
+                                                        const uchar *const src,                                     \
+                                                        const size_t num_bytes_per_element,                         \
+                                                        const size_t width,                                         \
+                                                        const size_t num_lines,                                     \
+                                                        const size_t src_element_bytes,                             \
+                                                        const size_t src_line_bytes,                                \
+                                                        const size_t dst_element_bytes,                             \
+                                                        const size_t dst_line_bytes) {                              \
+        typedef uchar __attribute__((vector_size(element_bytes), aligned(1), may_alias)) element_t;                 \
+        (void)num_bytes_per_element;                                                                                \
+                                                                                                                    \
+        for (size_t line = 0; line < num_lines; line++) {                                                           \
+            const uchar *src_ptr = src + (line * src_line_bytes);                                                   \
+            uchar *dst_ptr = dst + (line * dst_line_bytes);                                                         \
+                                                                                                                    \
+            for (size_t x = 0; x < width; x++) {                                                                    \
+                *(element_t *)dst_ptr = *(const element_t *)src_ptr;                                                \
+                                                                                                                    \
+                src_ptr += src_element_bytes;                                                                       \
+                dst_ptr += dst_element_bytes;                                                                       \
+            }                                                                                                       \
+        }                                                                                                           \
+    }
+
+__TTL_create_copy_block_kernel(1);
+__TTL_create_copy_block_kernel(2);
+__TTL_create_copy_block_kernel(8);
+__TTL_create_copy_block_kernel(16);
+
+#if defined(__has_builtin)
+#if __has_builtin(__builtin_shufflevector)
+#define __TTL_COPY_BLOCK_TRANSPOSE_4X4
+#endif
+#endif
+
+/**
+ * @brief Copy a block of 4 byte elements.
+ *
+ * A block that is contiguous along one axis in the source and along the other in the
+ * destination, as for a 2D transpose, is copied in 4x4 sub blocks each loaded as 4
+ * vectors, transposed in registers and stored as 4 vectors.
+ */
+static inline void __TTL_copy_block_4(uchar *const dst, const uchar *const src, const size_t num_bytes_per_element,
+                                      const size_t width, const size_t num_lines, const size_t src_element_bytes,
+                                      const size_t src_line_bytes, const size_t dst_element_bytes,
+                                      const size_t dst_line_bytes) {
+    typedef uchar __attribute__((vector_size(4), aligned(1), may_alias)) element_t;
+    size_t done_width = 0;
+    size_t done_lines = 0;
+
+    (void)num_bytes_per_element;
+
+#ifdef __TTL_COPY_BLOCK_TRANSPOSE_4X4
+    typedef uint __attribute__((vector_size(16), aligned(1), may_alias)) row_t;
+
+    // Vectors are loaded along the source's contiguous axis and stored along the destination's.
+    const bool along_lines = (src_line_bytes == 4) && (dst_element_bytes == 4);
+    const bool along_elements = (src_element_bytes == 4) && (dst_line_bytes == 4);
+
+    if (along_lines || along_elements) {
+        const size_t load_step = along_lines ? src_element_bytes : src_line_bytes;
+        const size_t store_step = along_lines ? dst_line_bytes : dst_element_bytes;
+
+        done_width = width & ~(size_t)3;
+        done_lines = num_lines & ~(size_t)3;
+
+        for (size_t line = 0; line < done_lines; line += 4) {
+            for (size_t x = 0; x < done_width; x += 4) {
+                const uchar *const src_ptr = src + (line * src_line_bytes) + (x * src_element_bytes);
+                uchar *const dst_ptr = dst + (line * dst_line_bytes) + (x * dst_element_bytes);
+                const row_t v0 = *(const row_t *)src_ptr;
+                const row_t v1 = *(const row_t *)(src_ptr + load_step);
+                const row_t v2 = *(const row_t *)(src_ptr + (2 * load_step));
+                const row_t v3 = *(const row_t *)(src_ptr + (3 * load_step));
+                const row_t t0 = __builtin_shufflevector(v0, v1, 0, 4, 1, 5);
+                const row_t t1 = __builtin_shufflevector(v0, v1, 2, 6, 3, 7);
+                const row_t t2 = __builtin_shufflevector(v2, v3, 0, 4, 1, 5);
+                const row_t t3 = __builtin_shufflevector(v2, v3, 2, 6, 3, 7);
+
+                *(row_t *)dst_ptr = __builtin_shufflevector(t0, t2, 0, 1, 4, 5);
+                *(row_t *)(dst_ptr + store_step) = __builtin_shufflevector(t0, t2, 2, 3, 6, 7);
+                *(row_t *)(dst_ptr + (2 * store_step)) = __builtin_shufflevector(t1, t3, 0, 1, 4, 5);
+                *(row_t *)(dst_ptr + (3 * store_step)) = __builtin_shufflevector(t1, t3, 2, 3, 6, 7);
+            }
+        }
+    }
+#endif
+
+    // Whatever the 4x4 sub blocks did not cover, the right hand columns then the bottom lines.
+    for (size_t line = 0; line < num_lines; line++) {
+        for (size_t x = (line < done_lines) ? done_width : 0; x < width; x++) {
+            *(element_t *)(dst + (line * dst_line_bytes) + (x * dst_element_bytes)) =
+                *(const element_t *)(src + (line * src_line_bytes) + (x * src_element_bytes));
+        }
+    }
+}
+
+/**
+ * @brief Return the kernel for blocks of num_bytes_per_element sized elements.
+ */
+static inline __TTL_copy_block_kernel_t __TTL_copy_block_kernel(const size_t num_bytes_per_element) {
+    switch (num_bytes_per_element) {
+        case 1: return __TTL_copy_block_1;
+        case 2: return __TTL_copy_block_2;
+        case 4: return __TTL_copy_block_4;
+        case 8: return __TTL_copy_block_8;
+        case 16: return __TTL_copy_block_16;
+        default: return __TTL_copy_block_memcpy;
+    }
+}
+
+static inline void __TTL_copy_swap(size_t *const a, size_t *const b) {
+    const size_t swap = *a;
+
+    *a = *b;
+    *b = swap;
+}
+
+/**
+ * @brief Copy a 3D block of elements that need not be contiguous in the source or destination.
+ *
+ * The copy is split into square blocks of TTL_PERMUTED_COPY_BLOCK elements in x and in
+ * whichever of y and z is closer to contiguous, so that a transposing copy reuses each
+ * cache line it reads or writes. All of the spacings are in bytes.
+ */
+static inline void __TTL_copy_permuted(uchar *const dst, const uchar *const src, const size_t num_bytes_per_element,
+                                       const size_t width, size_t num_lines, size_t num_planes,
+                                       const size_t src_element_bytes, size_t src_line_bytes, size_t src_plane_bytes,
+                                       const size_t dst_element_bytes, size_t dst_line_bytes, size_t dst_plane_bytes) {
+    const __TTL_copy_block_kernel_t kernel = __TTL_copy_block_kernel(num_bytes_per_element);
+    const size_t block = TTL_PERMUTED_COPY_BLOCK;
+
+    // Each element is copied once whatever the order, so the y and z axes can be exchanged.
+    if ((src_plane_bytes + dst_plane_bytes) < (src_line_bytes + dst_line_bytes)) {
+        __TTL_copy_swap(&num_lines, &num_planes);
+        __TTL_copy_swap(&src_line_bytes, &src_plane_bytes);
+        __TTL_copy_swap(&dst_line_bytes, &dst_plane_bytes);
+    }
+
+    for (size_t plane = 0; plane < num_planes; plane++) {
+        for (size_t line = 0; line < num_lines; line += block) {
+            for (size_t x = 0; x < width; x += block) {
+                kernel(dst + (plane * dst_plane_bytes) + (line * dst_line_bytes) + (x * dst_element_bytes),
+                       src + (plane * src_plane_bytes) + (line * src_line_bytes) + (x * src_element_bytes),
+                       num_bytes_per_element,
+                       (width - x) < block ? (width - x) : block,
+                       (num_lines - line) < block ? (num_lines - line) : block,
+                       src_element_bytes,
+                       src_line_bytes,
+                       dst_element_bytes,
+                       dst_line_bytes);
+            }
+        }
+    }
+}
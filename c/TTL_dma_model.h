@@ -0,0 +1,321 @@
+/*
+ * TTL_dma_model.h
+ *
+ * Copyright (c) 2023 Mobileye
+ *
+ * Licensed under the Apache License, Version 2.0 (the License);
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+/**
+ * @file
+ *
+ * Performance model of a DMA engine for the C target, included by TTL_copy_engine.h
+ * when TTL_DMA_MODEL is defined.
+ *
+ * Each copy engine channel behaves as a DMA channel that takes
+ *
+ *     setup_cycles + (rows * row_cycles) + (bytes / bytes_per_cycle)
+ *
+ * cycles per transfer, at a clock of TTL_DMA_MODEL_CLOCK_MHZ. A channel performs the copy
+ * and then holds the transfer's event incomplete until that time has passed, so kernels
+ * stall in TTL_wait as they would on the modelled hardware. The cycles each channel was
+ * busy and the cycles the kernel spent waiting are recorded, allowing pipelining schemes
+ * and tile shapes to be compared with TTL_dma_model_print.
+ *
+ * The model only delays completion, a transfer cannot complete faster than the host
+ * performs the copy, and the cycles by which it was late are reported as overrun. For
+ * faithful results the host needs a processor for each channel as well as for compute.
+ * Compute runs at host speed, so the clock is best chosen so that host compute takes a
+ * similar number of cycles to the target's. Elapsed cycles include everything the
+ * program does after the first transfer, TTL_dma_model_reset restarts the count.
+ */
+
+#include <sched.h>
+#include <stdio.h>
+#include <time.h>
+
+/**
+ * @def TTL_DMA_MODEL_CLOCK_MHZ
+ *
+ * @brief The clock the modelled cycles are counted in.
+ */
+#ifndef TTL_DMA_MODEL_CLOCK_MHZ
+#define TTL_DMA_MODEL_CLOCK_MHZ 1000
+#endif
+
+/**
+ * @def TTL_DMA_MODEL_SETUP_CYCLES
+ *
+ * @brief The default cycles to start each transfer, see TTL_dma_model_configure.
+ */
+#ifndef TTL_DMA_MODEL_SETUP_CYCLES
+#define TTL_DMA_MODEL_SETUP_CYCLES 100
+#endif
+
+/**
+ * @def TTL_DMA_MODEL_BYTES_PER_CYCLE
+ *
+ * @brief The default bandwidth of each channel, see TTL_dma_model_configure.
+ */
+#ifndef TTL_DMA_MODEL_BYTES_PER_CYCLE
+#define TTL_DMA_MODEL_BYTES_PER_CYCLE 16
+#endif
+
+/**
+ * @def TTL_DMA_MODEL_ROW_CYCLES
+ *
+ * @brief The default overhead of each row of a transfer, see TTL_dma_model_configure.
+ */
+#ifndef TTL_DMA_MODEL_ROW_CYCLES
+#define TTL_DMA_MODEL_ROW_CYCLES 4
+#endif
+
+/**
+ * @brief The modelled timing of a channel.
+ */
+typedef struct {
+    double setup_cycles;     ///< Cycles to start a transfer
+    double bytes_per_cycle;  ///< Bytes moved per cycle once started
+    double row_cycles;       ///< Cycles added for each row of a transfer
+} __TTL_dma_channel_model_t;
+
+/**
+ * @brief Activity of a modelled channel.
+ */
+typedef struct {
+    unsigned long transfers;   ///< Transfers completed
+    unsigned long long bytes;  ///< Bytes transferred
+    double busy_cycles;        ///< Cycles spent transferring
+    double overrun_cycles;     ///< Cycles by which the host took longer than the model
+} TTL_dma_model_channel_stats_t;
+
+/**
+ * @brief Activity recorded by the model since the engine started or TTL_dma_model_reset.
+ */
+typedef struct {
+    double elapsed_cycles;                                              ///< Cycles since recording began
+    double stall_cycles;                                                ///< Cycles spent waiting for transfers
+    TTL_dma_model_channel_stats_t channels[TTL_COPY_ENGINE_CHANNELS];  ///< Activity of each channel
+} TTL_dma_model_stats_t;
+
+/**
+ * @brief The state of the model.
+ */
+typedef struct {
+    pthread_mutex_t lock;  ///< Protects all other members
+    bool initialised;      ///< The channels have been given their default timing
+    __TTL_dma_channel_model_t channels[TTL_COPY_ENGINE_CHANNELS];
+    struct timespec start;  ///< When recording began
+    TTL_dma_model_stats_t stats;
+} __TTL_dma_model_t;
+
+/**
+ * @brief The model of the program.
+ *
+ * Unlike the copy engine this is shared by every translation unit, so that the activity
+ * of kernels can be configured and reported by separately compiled host code. Every
+ * translation unit must therefore use the same TTL_COPY_ENGINE_CHANNELS.
+ */
+__attribute__((weak)) __TTL_dma_model_t __TTL_dma_model_state = {
+    PTHREAD_MUTEX_INITIALIZER, false, { { 0, 0, 0 } }, { 0, 0 }, { 0, 0, { { 0, 0, 0, 0 } } }
+};
+
+/**
+ * @brief Return the nanoseconds from start to end.
+ */
+static inline double __TTL_dma_model_ns(const struct timespec *const start, const struct timespec *const end) {
+    return ((end->tv_sec - start->tv_sec) * 1e9) + (end->tv_nsec - start->tv_nsec);
+}
+
+static inline double __TTL_dma_model_ns_to_cycles(const double ns) {
+    return ns * (TTL_DMA_MODEL_CLOCK_MHZ) / 1e3;
+}
+
+/**
+ * @brief Lock the model, giving the channels their default timing on first use.
+ */
+static inline void __TTL_dma_model_lock(__TTL_NO_PARAMETERS) {
+    pthread_mutex_lock(&__TTL_dma_model_state.lock);
+
+    if (__TTL_dma_model_state.initialised == false) {
+        for (unsigned int channel = 0; channel < TTL_COPY_ENGINE_CHANNELS; channel++) {
+            __TTL_dma_model_state.channels[channel].setup_cycles = TTL_DMA_MODEL_SETUP_CYCLES;
+            __TTL_dma_model_state.channels[channel].bytes_per_cycle = TTL_DMA_MODEL_BYTES_PER_CYCLE;
+            __TTL_dma_model_state.channels[channel].row_cycles = TTL_DMA_MODEL_ROW_CYCLES;
+        }
+
+        clock_gettime(CLOCK_MONOTONIC, &__TTL_dma_model_state.start);
+        __TTL_dma_model_state.initialised = true;
+    }
+}
+
+static inline void __TTL_dma_model_unlock(__TTL_NO_PARAMETERS) {
+    pthread_mutex_unlock(&__TTL_dma_model_state.lock);
+}
+
+/**
+ * @brief Return the cycles a channel takes to perform a descriptor.
+ */
+static inline double __TTL_dma_model_cycles(const __TTL_dma_channel_model_t *const channel,
+                                            const __TTL_copy_descriptor_t *const descriptor) {
+    const bool permuted = (descriptor->src_element_spacing != 1) || (descriptor->dst_element_spacing != 1);
+    const size_t lines = descriptor->num_lines * descriptor->num_planes;
+    const size_t bytes = descriptor->num_bytes_per_element * descriptor->num_elements_per_line * lines;
+    // A permuted line is not contiguous, so each of its elements is a separate row.
+    const size_t rows = permuted ? lines * descriptor->num_elements_per_line : lines;
+
+    return channel->setup_cycles + (rows * channel->row_cycles) + (bytes / channel->bytes_per_cycle);
+}
+
+/**
+ * @brief Return once cycles have passed since start.
+ *
+ * Modelled transfers are often shorter than the resolution of a sleep, so the last part
+ * of the wait spins, yielding in case compute is waiting for the processor.
+ */
+static inline void __TTL_dma_model_delay(const struct timespec *const start, const double cycles) {
+    const double spin_ns = 100e3;
+    const double ns = cycles * 1e3 / (TTL_DMA_MODEL_CLOCK_MHZ);
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    if ((ns - __TTL_dma_model_ns(start, &now)) > spin_ns) {
+        const long long wake_ns = (start->tv_sec * 1000000000LL) + start->tv_nsec + (long long)(ns - spin_ns);
+        struct timespec wake;
+
+        wake.tv_sec = wake_ns / 1000000000LL;
+        wake.tv_nsec = wake_ns % 1000000000LL;
+
+        while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &wake, NULL) != 0) {
+        }
+    }
+
+    for (clock_gettime(CLOCK_MONOTONIC, &now); __TTL_dma_model_ns(start, &now) < ns;
+         clock_gettime(CLOCK_MONOTONIC, &now)) {
+        sched_yield();
+    }
+}
+
+/**
+ * @brief Perform a descriptor as channel would, returning when the modelled transfer completes.
+ */
+static inline void __TTL_dma_model_execute(const unsigned int channel,
+                                           const __TTL_copy_descriptor_t *const descriptor) {
+    struct timespec start;
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+    __TTL_dma_model_lock();
+    const double cycles = __TTL_dma_model_cycles(&__TTL_dma_model_state.channels[channel], descriptor);
+    __TTL_dma_model_unlock();
+
+    __TTL_copy_descriptor_execute(descriptor);
+    __TTL_dma_model_delay(&start, cycles);
+
+    struct timespec end;
+
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    const double host_cycles = __TTL_dma_model_ns_to_cycles(__TTL_dma_model_ns(&start, &end));
+
+    __TTL_dma_model_lock();
+    TTL_dma_model_channel_stats_t *const stats = &__TTL_dma_model_state.stats.channels[channel];
+    stats->transfers++;
+    stats->bytes += descriptor->num_bytes_per_element * descriptor->num_elements_per_line * descriptor->num_lines *
+                    descriptor->num_planes;
+    stats->busy_cycles += cycles;
+    if (host_cycles > cycles) stats->overrun_cycles += host_cycles - cycles;
+    __TTL_dma_model_unlock();
+}
+
+/**
+ * @brief Record time the kernel spent waiting for transfers.
+ */
+static inline void __TTL_dma_model_stalled(const struct timespec *const start, const struct timespec *const end) {
+    __TTL_dma_model_lock();
+    __TTL_dma_model_state.stats.stall_cycles += __TTL_dma_model_ns_to_cycles(__TTL_dma_model_ns(start, end));
+    __TTL_dma_model_unlock();
+}
+
+/**
+ * @brief Set the modelled timing of a channel.
+ *
+ * Channels default to TTL_DMA_MODEL_SETUP_CYCLES, TTL_DMA_MODEL_BYTES_PER_CYCLE and
+ * TTL_DMA_MODEL_ROW_CYCLES. The timing should be set before transfers are issued.
+ *
+ * @param channel The channel to configure, channels that do not exist are ignored.
+ * @param setup_cycles Cycles to start a transfer.
+ * @param bytes_per_cycle Bytes moved per cycle once started, must be greater than 0.
+ * @param row_cycles Cycles added for each row of a transfer.
+ */
+static inline void TTL_dma_model_configure(const unsigned int channel, const double setup_cycles,
+                                           const double bytes_per_cycle, const double row_cycles) {
+    if (channel >= TTL_COPY_ENGINE_CHANNELS) return;
+
+    __TTL_dma_model_lock();
+    __TTL_dma_model_state.channels[channel].setup_cycles = setup_cycles;
+    __TTL_dma_model_state.channels[channel].bytes_per_cycle = bytes_per_cycle;
+    __TTL_dma_model_state.channels[channel].row_cycles = row_cycles;
+    __TTL_dma_model_unlock();
+}
+
+/**
+ * @brief Clear the recorded activity and restart the elapsed cycle count.
+ */
+static inline void TTL_dma_model_reset(__TTL_NO_PARAMETERS) {
+    __TTL_dma_model_lock();
+    memset(&__TTL_dma_model_state.stats, 0, sizeof(__TTL_dma_model_state.stats));
+    clock_gettime(CLOCK_MONOTONIC, &__TTL_dma_model_state.start);
+    __TTL_dma_model_unlock();
+}
+
+/**
+ * @brief Return the activity recorded since the first transfer or TTL_dma_model_reset.
+ */
+static inline TTL_dma_model_stats_t TTL_dma_model_stats(__TTL_NO_PARAMETERS) {
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    __TTL_dma_model_lock();
+    TTL_dma_model_stats_t result = __TTL_dma_model_state.stats;
+    result.elapsed_cycles = __TTL_dma_model_ns_to_cycles(__TTL_dma_model_ns(&__TTL_dma_model_state.start, &now));
+    __TTL_dma_model_unlock();
+
+    return result;
+}
+
+/**
+ * @brief Print the activity recorded since the first transfer or TTL_dma_model_reset.
+ */
+static inline void TTL_dma_model_print(__TTL_NO_PARAMETERS) {
+    const TTL_dma_model_stats_t stats = TTL_dma_model_stats();
+
+    printf("DMA model: %.0f cycles, waiting for transfers %.0f cycles (%.1f%%)\n",
+           stats.elapsed_cycles,
+           stats.stall_cycles,
+           100.0 * stats.stall_cycles / stats.elapsed_cycles);
+
+    for (unsigned int channel = 0; channel < TTL_COPY_ENGINE_CHANNELS; channel++) {
+        printf("    channel %u: %lu transfers, %llu bytes, busy %.0f cycles (%.1f%%), host overrun %.0f cycles\n",
+               channel,
+               stats.channels[channel].transfers,
+               stats.channels[channel].bytes,
+               stats.channels[channel].busy_cycles,
+               100.0 * stats.channels[channel].busy_cycles / stats.elapsed_cycles,
+               stats.channels[channel].overrun_cycles);
+    }
+}
@@ -0,0 +1,367 @@
+/*
+ * TTL_file_tensors.h
+ *
+ * Copyright (c) 2023 Mobileye
+ *
+ * Licensed under the Apache License, Version 2.0 (the License);
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+/*
+ * File backed external memory for the C target, enabled by defining TTL_FILE_TENSORS.
+ *
+ * TTL_attach_file reserves an inaccessible range of addresses the size of the file
+ * region and returns its base. External tensors are created from that base exactly as
+ * from any other pointer, and transfers to or from the range are performed with pread
+ * and pwrite of each line at the matching file offset. No memory is committed to the
+ * range, so tensors bigger than RAM can be tiled, and with TTL_COPY_ENGINE the reads
+ * and writes happen on the engine's channels so that the pipelining schemes overlap
+ * them with compute.
+ *
+ * Only TTL transfers may access the range, anything else faults.
+ *
+ * TTL_map_file is a lighter alternative that maps the file into memory, so that it is
+ * ordinary memory copied with the usual kernels and may be accessed directly. The
+ * pipelining schemes then use TTL_prefetch_tile to have the pages of upcoming tiles
+ * read in the background, rather than each import faulting them in.
+ */
+
+#include <errno.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <sys/mman.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+/**
+ * @def TTL_FILE_TENSORS_MAX
+ *
+ * @brief The number of files that may be attached at once.
+ */
+#ifndef TTL_FILE_TENSORS_MAX
+#define TTL_FILE_TENSORS_MAX 16
+#endif
+
+/**
+ * @brief A file region attached by TTL_attach_file, free when base is NULL.
+ */
+typedef struct {
+    uchar *base;   ///< The start of the reserved address range
+    size_t size;   ///< The size of the range and the file region in bytes
+    int fd;        ///< The file descriptor transfers are performed with
+    off_t offset;  ///< The file offset that base corresponds to
+    int error;     ///< The errno of the first failed transfer, or 0
+    bool mapped;   ///< The file is mapped at base by TTL_map_file rather than attached
+} __TTL_file_region_t;
+
+/**
+ * @brief The attached file regions.
+ */
+typedef struct {
+    pthread_mutex_t lock;
+    __TTL_file_region_t regions[TTL_FILE_TENSORS_MAX];
+} __TTL_file_regions_t;
+
+/**
+ * @brief The attached file regions of the program.
+ *
+ * Unlike the rest of TTL this is shared by every translation unit, as files are
+ * commonly attached by host code and imported from by a kernel compiled separately.
+ */
+__attribute__((weak)) __TTL_file_regions_t __TTL_file_regions = { PTHREAD_MUTEX_INITIALIZER,
+                                                                   { { NULL, 0, 0, 0, 0, false } } };
+
+/**
+ * @brief Return the attached region containing address, or NULL if there is none.
+ */
+static inline __TTL_file_region_t *__TTL_file_find(const void *const address) {
+    __TTL_file_region_t *result = NULL;
+
+    pthread_mutex_lock(&__TTL_file_regions.lock);
+
+    for (unsigned int i = 0; (i < TTL_FILE_TENSORS_MAX) && (result == NULL); i++) {
+        __TTL_file_region_t *const region = &__TTL_file_regions.regions[i];
+
+        if ((region->base != NULL) && ((const uchar *)address >= region->base) &&
+            ((const uchar *)address < (region->base + region->size))) {
+            result = region;
+        }
+    }
+
+    pthread_mutex_unlock(&__TTL_file_regions.lock);
+
+    return result;
+}
+
+/**
+ * @brief Return the attached region containing address if it must be transferred with pread and pwrite.
+ */
+static inline __TTL_file_region_t *__TTL_file_io_find(const void *const address) {
+    __TTL_file_region_t *const region = __TTL_file_find(address);
+
+    return ((region != NULL) && (region->mapped == false)) ? region : NULL;
+}
+
+/**
+ * @brief Attached file memory cannot be referenced in place, @see TTL_ZERO_COPY_IMPORT
+ */
+#define __TTL_ext_addressable(address) (__TTL_file_io_find((const void *)(address)) == NULL)
+
+/**
+ * @brief Add a region for base, returning false if there is no space.
+ */
+static inline bool __TTL_file_add(uchar *const base, const size_t size, const int fd, const off_t offset,
+                                  const bool mapped) {
+    __TTL_file_region_t *region = NULL;
+
+    pthread_mutex_lock(&__TTL_file_regions.lock);
+
+    for (unsigned int i = 0; (i < TTL_FILE_TENSORS_MAX) && (region == NULL); i++) {
+        if (__TTL_file_regions.regions[i].base == NULL) region = &__TTL_file_regions.regions[i];
+    }
+
+    if (region != NULL) {
+        region->base = base;
+        region->size = size;
+        region->fd = fd;
+        region->offset = offset;
+        region->error = 0;
+        region->mapped = mapped;
+    }
+
+    pthread_mutex_unlock(&__TTL_file_regions.lock);
+
+    return region != NULL;
+}
+
+/**
+ * @brief Attach part of a file as external memory.
+ *
+ * @param fd A file descriptor open for reading, and for writing if the memory is exported to.
+ * @param offset The offset in the file of the first byte of the memory.
+ * @param size The size of the memory in bytes.
+ *
+ * The file is not read until data is imported, and exports write the file directly. The
+ * descriptor must remain open until TTL_detach_file.
+ *
+ * @return The base address to create external tensors from, or NULL if the file could not
+ * be attached.
+ */
+static inline void *TTL_attach_file(const int fd, const off_t offset, const size_t size) {
+    void *const base = mmap(NULL, size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+
+    if (base == MAP_FAILED) return NULL;
+
+    if (__TTL_file_add((uchar *)base, size, fd, offset, false) == false) {
+        munmap(base, size);
+        return NULL;
+    }
+
+    return base;
+}
+
+/**
+ * @brief Map part of a file as external memory.
+ *
+ * @param fd A file descriptor open for reading, and for writing if writable.
+ * @param offset The offset in the file of the first byte of the memory.
+ * @param size The size of the memory in bytes.
+ * @param writable True if the memory will be exported to, the file is then updated.
+ *
+ * @return The base address to create external tensors from, or NULL if the file could not
+ * be mapped.
+ */
+static inline void *TTL_map_file(const int fd, const off_t offset, const size_t size, const bool writable) {
+    const size_t page_offset = (size_t)offset % (size_t)sysconf(_SC_PAGESIZE);
+    void *const mapping = mmap(NULL,
+                               size + page_offset,
+                               writable ? (PROT_READ | PROT_WRITE) : PROT_READ,
+                               MAP_SHARED,
+                               fd,
+                               offset - page_offset);
+
+    if (mapping == MAP_FAILED) return NULL;
+
+    uchar *const base = (uchar *)mapping + page_offset;
+
+    if (__TTL_file_add(base, size, fd, offset, true) == false) {
+        munmap(mapping, size + page_offset);
+        return NULL;
+    }
+
+    return base;
+}
+
+/**
+ * @brief Detach memory attached with TTL_attach_file or unmap memory mapped with TTL_map_file.
+ *
+ * All transfers to and from the memory must have been waited for.
+ *
+ * @param base The address returned by TTL_attach_file or TTL_map_file.
+ *
+ * @return 0 if every transfer succeeded, otherwise the errno of the first that failed.
+ */
+static inline int TTL_detach_file(void *const base) {
+    __TTL_file_region_t *const region = __TTL_file_find(base);
+
+    if (region == NULL) return EINVAL;
+
+    pthread_mutex_lock(&__TTL_file_regions.lock);
+
+    const size_t page_offset = region->mapped ? ((size_t)region->offset % (size_t)sysconf(_SC_PAGESIZE)) : 0;
+    const int error = region->error;
+    munmap(region->base - page_offset, region->size + page_offset);
+    region->base = NULL;
+
+    pthread_mutex_unlock(&__TTL_file_regions.lock);
+
+    return error;
+}
+
+/**
+ * @brief Record the first error for a region.
+ */
+static inline void __TTL_file_set_error(__TTL_file_region_t *const region, const int error) {
+    pthread_mutex_lock(&__TTL_file_regions.lock);
+
+    if (region->error == 0) region->error = error;
+
+    pthread_mutex_unlock(&__TTL_file_regions.lock);
+}
+
+/**
+ * @brief Read num_bytes of a region at address into dst.
+ *
+ * Bytes past the end of the file, or that could not be read, are zero.
+ */
+static inline void __TTL_file_read(__TTL_file_region_t *const region, uchar *dst, const uchar *const address,
+                                   size_t num_bytes) {
+    off_t offset = region->offset + (address - region->base);
+
+    while (num_bytes != 0) {
+        const ssize_t result = pread(region->fd, dst, num_bytes, offset);
+
+        if ((result < 0) && (errno == EINTR)) continue;
+
+        if (result <= 0) {
+            if (result < 0) __TTL_file_set_error(region, errno);
+            memset(dst, 0, num_bytes);
+            return;
+        }
+
+        dst += result;
+        offset += result;
+        num_bytes -= result;
+    }
+}
+
+/**
+ * @brief Write num_bytes from src to a region at address.
+ */
+static inline void __TTL_file_write(__TTL_file_region_t *const region, const uchar *const address, const uchar *src,
+                                    size_t num_bytes) {
+    off_t offset = region->offset + (address - region->base);
+
+    while (num_bytes != 0) {
+        const ssize_t result = pwrite(region->fd, src, num_bytes, offset);
+
+        if ((result < 0) && (errno == EINTR)) continue;
+
+        if (result <= 0) {
+            __TTL_file_set_error(region, (result < 0) ? errno : EIO);
+            return;
+        }
+
+        src += result;
+        offset += result;
+        num_bytes -= result;
+    }
+}
+
+/**
+ * @brief Perform a 3D copy if either side is attached file memory.
+ *
+ * Parameters are as __TTL_copy_rows_kernel_t, each line being one read or write, so
+ * lines the import or export coalesced become a single transfer.
+ *
+ * @return false, having done nothing, if neither side is attached file memory.
+ */
+static inline bool __TTL_file_copy_3D3D(uchar *const dst, const uchar *const src, const size_t row_bytes,
+                                        const size_t num_lines, const size_t num_planes, const size_t src_line_bytes,
+                                        const size_t src_plane_bytes, const size_t dst_line_bytes,
+                                        const size_t dst_plane_bytes) {
+    __TTL_file_region_t *const src_region = __TTL_file_io_find(src);
+    __TTL_file_region_t *const dst_region = __TTL_file_io_find(dst);
+
+    if ((src_region == NULL) && (dst_region == NULL)) return false;
+
+    // Only needed to copy from one file to another.
+    uchar *const bounce = ((src_region != NULL) && (dst_region != NULL)) ? (uchar *)malloc(row_bytes) : NULL;
+
+    for (size_t plane = 0; plane < num_planes; plane++) {
+        for (size_t line = 0; line < num_lines; line++) {
+            uchar *const dst_line = dst + (plane * dst_plane_bytes) + (line * dst_line_bytes);
+            const uchar *const src_line = src + (plane * src_plane_bytes) + (line * src_line_bytes);
+
+            if (dst_region == NULL) {
+                __TTL_file_read(src_region, dst_line, src_line, row_bytes);
+            } else if (src_region == NULL) {
+                __TTL_file_write(dst_region, dst_line, src_line, row_bytes);
+            } else if (bounce != NULL) {
+                __TTL_file_read(src_region, bounce, src_line, row_bytes);
+                __TTL_file_write(dst_region, dst_line, bounce, row_bytes);
+            } else {
+                __TTL_file_set_error(dst_region, ENOMEM);
+            }
+        }
+    }
+
+    free(bounce);
+
+    return true;
+}
+
+/**
+ * @brief Have the pages of a block of mapped file memory read in the background.
+ *
+ * Parameters are as __TTL_copy_3D3D with sizes in elements. Each plane is advised as one
+ * range unless lines are far enough apart that the range would be mostly other data.
+ */
+static inline void __TTL_file_prefetch_3D(const void *const address, const size_t num_bytes_per_element,
+                                          const size_t num_elements_per_line, const size_t num_lines,
+                                          const size_t num_planes, const size_t total_line_length,
+                                          const size_t total_plane_spacing) {
+    const __TTL_file_region_t *const region = __TTL_file_find(address);
+
+    if ((region == NULL) || (region->mapped == false)) return;
+
+    const uintptr_t page_size = (uintptr_t)sysconf(_SC_PAGESIZE);
+    const size_t row_bytes = num_elements_per_line * num_bytes_per_element;
+    const size_t line_bytes = total_line_length * num_bytes_per_element;
+    const bool per_line = line_bytes >= (2 * page_size) + row_bytes;
+    const size_t block_lines = per_line ? 1 : num_lines;
+
+    for (size_t plane = 0; plane < num_planes; plane++) {
+        for (size_t line = 0; line < num_lines; line += block_lines) {
+            const uintptr_t begin = (uintptr_t)address + (plane * total_plane_spacing * num_bytes_per_element) +
+                                    (line * line_bytes);
+            const uintptr_t end = begin + ((block_lines - 1) * line_bytes) + row_bytes;
+            const uintptr_t page = begin & ~(page_size - 1);
+
+            madvise((void *)page, end - page, MADV_WILLNEED);
+        }
+    }
+}
+
+#define __TTL_prefetch_3D __TTL_file_prefetch_3D
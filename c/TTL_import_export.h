@@ -18,6 +18,7 @@
 
 #pragma once
 
+#include <limits.h>
 #include <stddef.h>
 #include <stdint.h>
 #include <stdio.h>
@@ -32,6 +33,216 @@
  */
 typedef event_t TTL_event_t;
 
+#include "TTL_copy_kernels.h"
+
+#ifdef TTL_FILE_TENSORS
+#include "TTL_file_tensors.h"
+#endif
+
+/**
+ * @brief Copy a 3D block of memory, returning when complete.
+ *
+ * Each line is copied by the kernel __TTL_copy_rows_kernel selects for the line length, or read
+ * or written with pread or pwrite if either side is file memory (see TTL_file_tensors.h).
+ *
+ * @param dst Base address of the destination
+ * @param src Base address of the source
+ * @param num_bytes_per_element Size of each element in bytes
+ * @param num_elements_per_line Elements copied per line
+ * @param num_lines Lines copied per plane
+ * @param num_planes Planes copied
+ * @param src_total_line_length Source line spacing in elements
+ * @param src_total_plane_spacing Source plane spacing in elements
+ * @param dst_total_line_length Destination line spacing in elements
+ * @param dst_total_plane_spacing Destination plane spacing in elements
+ * @param streaming Write the destination with non-temporal stores where possible
+ */
+static inline void __TTL_copy_3D3D(void *const dst, const void *const src, size_t num_bytes_per_element,
+                                   size_t num_elements_per_line, size_t num_lines, size_t num_planes,
+                                   size_t src_total_line_length, size_t src_total_plane_spacing,
+                                   size_t dst_total_line_length, size_t dst_total_plane_spacing,
+                                   const bool streaming) {
+    const size_t row_bytes = num_bytes_per_element * num_elements_per_line;
+
+#ifdef TTL_FILE_TENSORS
+    if (__TTL_file_copy_3D3D((uchar *)dst,
+                             (const uchar *)src,
+                             row_bytes,
+                             num_lines,
+                             num_planes,
+                             src_total_line_length * num_bytes_per_element,
+                             src_total_plane_spacing * num_bytes_per_element,
+                             dst_total_line_length * num_bytes_per_element,
+                             dst_total_plane_spacing * num_bytes_per_element)) {
+        return;
+    }
+#endif
+
+    const __TTL_copy_rows_kernel_t kernel =
+        streaming ? __TTL_copy_rows_streaming_kernel(row_bytes) : __TTL_copy_rows_kernel(row_bytes);
+
+    kernel((uchar *)dst,
+           (const uchar *)src,
+           row_bytes,
+           num_lines,
+           num_planes,
+           src_total_line_length * num_bytes_per_element,
+           src_total_plane_spacing * num_bytes_per_element,
+           dst_total_line_length * num_bytes_per_element,
+           dst_total_plane_spacing * num_bytes_per_element);
+}
+
+/**
+ * @brief Copy a 3D block of memory whose lines need not be contiguous, returning when complete.
+ *
+ * As __TTL_copy_3D3D, with the spacing of the elements of a line given for both the
+ * source and the destination. Copies with contiguous lines are passed to __TTL_copy_3D3D,
+ * others are performed by __TTL_copy_permuted a block at a time. Where either side is
+ * file memory each element is read or written separately, which is correct but slow.
+ */
+static inline void __TTL_copy_permuted_3D3D(void *const dst, const void *const src, size_t num_bytes_per_element,
+                                            size_t num_elements_per_line, size_t num_lines, size_t num_planes,
+                                            size_t src_element_spacing, size_t src_total_line_length,
+                                            size_t src_total_plane_spacing, size_t dst_element_spacing,
+                                            size_t dst_total_line_length, size_t dst_total_plane_spacing) {
+    if ((src_element_spacing == 1) && (dst_element_spacing == 1)) {
+        __TTL_copy_3D3D(dst,
+                        src,
+                        num_bytes_per_element,
+                        num_elements_per_line,
+                        num_lines,
+                        num_planes,
+                        src_total_line_length,
+                        src_total_plane_spacing,
+                        dst_total_line_length,
+                        dst_total_plane_spacing,
+                        false);
+        return;
+    }
+
+#ifdef TTL_FILE_TENSORS
+    // Each line is copied as a column of single element lines.
+    if ((__TTL_file_io_find(src) != NULL) || (__TTL_file_io_find(dst) != NULL)) {
+        for (size_t plane = 0; plane < num_planes; plane++) {
+            for (size_t line = 0; line < num_lines; line++) {
+                __TTL_copy_3D3D(
+                    (uchar *)dst + (((plane * dst_total_plane_spacing) + (line * dst_total_line_length)) *
+                                    num_bytes_per_element),
+                    (const uchar *)src + (((plane * src_total_plane_spacing) + (line * src_total_line_length)) *
+                                          num_bytes_per_element),
+                    num_bytes_per_element,
+                    1,
+                    num_elements_per_line,
+                    1,
+                    src_element_spacing,
+                    0,
+                    dst_element_spacing,
+                    0,
+                    false);
+            }
+        }
+        return;
+    }
+#endif
+
+    __TTL_copy_permuted((uchar *)dst,
+                        (const uchar *)src,
+                        num_bytes_per_element,
+                        num_elements_per_line,
+                        num_lines,
+                        num_planes,
+                        src_element_spacing * num_bytes_per_element,
+                        src_total_line_length * num_bytes_per_element,
+                        src_total_plane_spacing * num_bytes_per_element,
+                        dst_element_spacing * num_bytes_per_element,
+                        dst_total_line_length * num_bytes_per_element,
+                        dst_total_plane_spacing * num_bytes_per_element);
+}
+
+#include "../opencl/TTL_convert.h"
+
+/**
+ * @brief Convert a 3D block of elements, returning when complete.
+ *
+ * As __TTL_convert_import_3D, which in C is the same as __TTL_convert_export_3D. Where either
+ * side is file memory the elements pass through a buffer a chunk at a time, the chunks being
+ * read or written by __TTL_copy_3D3D.
+ */
+static inline void __TTL_convert_3D3D(void *const dst, const void *const src, const TTL_conversion_t conversion,
+                                      size_t num_elements_per_line, size_t num_lines, size_t num_planes,
+                                      size_t src_total_line_length, size_t src_total_plane_spacing,
+                                      size_t dst_total_line_length, size_t dst_total_plane_spacing) {
+#ifdef TTL_FILE_TENSORS
+    if ((__TTL_file_io_find(src) != NULL) || (__TTL_file_io_find(dst) != NULL)) {
+        const size_t src_bytes = TTL_element_size(conversion.src_type);
+        const size_t dst_bytes = TTL_element_size(conversion.dst_type);
+        long src_chunk[__TTL_CONVERT_CHUNK];
+        long dst_chunk[__TTL_CONVERT_CHUNK];
+
+        for (size_t plane = 0; plane < num_planes; plane++) {
+            for (size_t line = 0; line < num_lines; line++) {
+                const uchar *const src_line =
+                    (const uchar *)src +
+                    (((plane * src_total_plane_spacing) + (line * src_total_line_length)) * src_bytes);
+                uchar *const dst_line =
+                    (uchar *)dst + (((plane * dst_total_plane_spacing) + (line * dst_total_line_length)) * dst_bytes);
+
+                for (size_t first = 0; first < num_elements_per_line; first += __TTL_CONVERT_CHUNK) {
+                    const size_t remaining = num_elements_per_line - first;
+                    const size_t count = remaining < __TTL_CONVERT_CHUNK ? remaining : __TTL_CONVERT_CHUNK;
+
+                    __TTL_copy_3D3D(
+                        src_chunk, src_line + (first * src_bytes), src_bytes, count, 1, 1, 0, 0, 0, 0, false);
+                    __TTL_convert_import_3D(dst_chunk, src_chunk, conversion, count, 1, 1, 0, 0, 0, 0);
+                    __TTL_copy_3D3D(
+                        dst_line + (first * dst_bytes), dst_chunk, dst_bytes, count, 1, 1, 0, 0, 0, 0, false);
+                }
+            }
+        }
+        return;
+    }
+#endif
+
+    __TTL_convert_import_3D(dst,
+                            src,
+                            conversion,
+                            num_elements_per_line,
+                            num_lines,
+                            num_planes,
+                            src_total_line_length,
+                            src_total_plane_spacing,
+                            dst_total_line_length,
+                            dst_total_plane_spacing);
+}
+
+/**
+ * @def TTL_EXPORT_STREAMING_THRESHOLD
+ *
+ * @brief Exports of at least this many bytes are written with non-temporal stores.
+ *
+ * An exported tile is not normally read again by the kernel, so writing it through the
+ * cache evicts the input tiles still being worked on. Not defined by default, in which
+ * case every export is written through the cache.
+ */
+
+/**
+ * @brief Return true if an export of num_bytes bytes should bypass the cache.
+ */
+static inline bool __TTL_export_streaming(const size_t num_bytes) {
+#ifdef TTL_EXPORT_STREAMING_THRESHOLD
+    return num_bytes >= (TTL_EXPORT_STREAMING_THRESHOLD);
+#else
+    (void)num_bytes;
+    return false;
+#endif
+}
+
+#ifdef TTL_COPY_ENGINE
+/*
+ * Perform the copies on a background thread so that they overlap with compute.
+ */
+#include "TTL_copy_engine.h"
+#else
 /**
  * @brief Wait for events that identify the async_work_group_copy operations to
  * complete.
@@ -39,7 +250,7 @@ typedef event_t TTL_event_t;
  * @param num_events Number of events to wait for (size of event_list)
  * @param event_list A pointer to a list of events.
  *
- * Not supported in the 'C' version.
+ * Not supported in the 'C' version unless TTL_COPY_ENGINE is defined.
  *
  * @see OpenCL's wait_group_events() builtin for more information.
  */
@@ -49,27 +260,134 @@ static inline void wait_group_events(int num_events, event_t *event_list) {
     // Nothing to do in C we have no events.
 }
 
-static inline event_t async_work_group_copy_3D3D(void *const dst, size_t dst_offset, const void *const src, size_t src_offset,
-                                   size_t num_bytes_per_element, size_t num_elements_per_line, size_t num_lines,
-                                   size_t num_planes, size_t src_total_line_length, size_t src_total_plane_spacing,
-                                   size_t dst_total_line_length, size_t dst_total_plane_spacing, event_t event) {
-    (void)dst_total_line_length;
-    (void)event;
+static inline event_t async_work_group_copy_3D3D(void *const dst, size_t dst_offset, const void *const src,
+                                                 size_t src_offset, size_t num_bytes_per_element,
+                                                 size_t num_elements_per_line, size_t num_lines, size_t num_planes,
+                                                 size_t src_total_line_length, size_t src_total_plane_spacing,
+                                                 size_t dst_total_line_length, size_t dst_total_plane_spacing,
+                                                 event_t event) {
+    __TTL_copy_3D3D((uchar *)dst + (dst_offset * num_bytes_per_element),
+                    (const uchar *)src + (src_offset * num_bytes_per_element),
+                    num_bytes_per_element,
+                    num_elements_per_line,
+                    num_lines,
+                    num_planes,
+                    src_total_line_length,
+                    src_total_plane_spacing,
+                    dst_total_line_length,
+                    dst_total_plane_spacing,
+                    false);
+
+    return event;
+}
+
+/**
+ * @brief The export used by TTL_export_base, as async_work_group_copy_3D3D but large
+ * exports are streamed, see TTL_EXPORT_STREAMING_THRESHOLD.
+ */
+static inline event_t __TTL_export_3D3D(void *const dst, size_t dst_offset, const void *const src, size_t src_offset,
+                                        size_t num_bytes_per_element, size_t num_elements_per_line, size_t num_lines,
+                                        size_t num_planes, size_t src_total_line_length,
+                                        size_t src_total_plane_spacing, size_t dst_total_line_length,
+                                        size_t dst_total_plane_spacing, event_t event) {
+    __TTL_copy_3D3D((uchar *)dst + (dst_offset * num_bytes_per_element),
+                    (const uchar *)src + (src_offset * num_bytes_per_element),
+                    num_bytes_per_element,
+                    num_elements_per_line,
+                    num_lines,
+                    num_planes,
+                    src_total_line_length,
+                    src_total_plane_spacing,
+                    dst_total_line_length,
+                    dst_total_plane_spacing,
+                    __TTL_export_streaming(num_bytes_per_element * num_elements_per_line * num_lines * num_planes));
 
-    for (size_t plane = 0; plane < num_planes; plane++) {
-        const uchar *src_ptr =
-            (uchar *)src + ((src_offset + (src_total_plane_spacing * plane)) * num_bytes_per_element);
-        uint8_t *dst_ptr = (uint8_t *)dst + ((dst_offset + (dst_total_plane_spacing * plane)) * num_bytes_per_element);
+    return event;
+}
 
-        for (size_t line = 0; line < num_lines; line++) {
-            memcpy(dst_ptr, src_ptr, num_bytes_per_element * num_elements_per_line);
+#define TTL_EXPORT_COPY_3D3D __TTL_export_3D3D
 
-            src_ptr += src_total_line_length * num_bytes_per_element;
-            dst_ptr += dst_total_line_length * num_bytes_per_element;
-        }
-    }
+/**
+ * @brief The permuted import used by TTL_import_permuted_base, @see TTL_IMPORT_PERMUTED_COPY
+ */
+static inline event_t __TTL_import_permuted_3D(void *const dst, const void *const src, size_t num_bytes_per_element,
+                                               size_t num_elements_per_line, size_t num_lines, size_t num_planes,
+                                               size_t src_element_spacing, size_t src_total_line_length,
+                                               size_t src_total_plane_spacing, size_t dst_total_line_length,
+                                               size_t dst_total_plane_spacing, event_t event) {
+    __TTL_copy_permuted_3D3D(dst,
+                             src,
+                             num_bytes_per_element,
+                             num_elements_per_line,
+                             num_lines,
+                             num_planes,
+                             src_element_spacing,
+                             src_total_line_length,
+                             src_total_plane_spacing,
+                             1,
+                             dst_total_line_length,
+                             dst_total_plane_spacing);
+
+    return event;
+}
+
+/**
+ * @brief The permuted export used by TTL_export_permuted_base, @see TTL_EXPORT_PERMUTED_COPY
+ */
+static inline event_t __TTL_export_permuted_3D(void *const dst, const void *const src, size_t num_bytes_per_element,
+                                               size_t num_elements_per_line, size_t num_lines, size_t num_planes,
+                                               size_t src_total_line_length, size_t src_total_plane_spacing,
+                                               size_t dst_element_spacing, size_t dst_total_line_length,
+                                               size_t dst_total_plane_spacing, event_t event) {
+    __TTL_copy_permuted_3D3D(dst,
+                             src,
+                             num_bytes_per_element,
+                             num_elements_per_line,
+                             num_lines,
+                             num_planes,
+                             1,
+                             src_total_line_length,
+                             src_total_plane_spacing,
+                             dst_element_spacing,
+                             dst_total_line_length,
+                             dst_total_plane_spacing);
+
+    return event;
+}
+
+#define TTL_IMPORT_PERMUTED_COPY __TTL_import_permuted_3D
+#define TTL_EXPORT_PERMUTED_COPY __TTL_export_permuted_3D
+
+/**
+ * @brief The converting import and export, @see TTL_IMPORT_CONVERTED_COPY
+ */
+static inline event_t __TTL_converted_copy_3D(void *const dst, const void *const src, const TTL_conversion_t conversion,
+                                              size_t num_elements_per_line, size_t num_lines, size_t num_planes,
+                                              size_t src_total_line_length, size_t src_total_plane_spacing,
+                                              size_t dst_total_line_length, size_t dst_total_plane_spacing,
+                                              event_t event) {
+    __TTL_convert_3D3D(dst,
+                       src,
+                       conversion,
+                       num_elements_per_line,
+                       num_lines,
+                       num_planes,
+                       src_total_line_length,
+                       src_total_plane_spacing,
+                       dst_total_line_length,
+                       dst_total_plane_spacing);
 
     return event;
 }
 
+#define TTL_IMPORT_CONVERTED_COPY __TTL_converted_copy_3D
+#define TTL_EXPORT_CONVERTED_COPY __TTL_converted_copy_3D
+#endif
+
+// Local memory is host memory, so a copy within it is issued as an import.
+#define TTL_LOCAL_COPY_3D TTL_IMPORT_COPY_3D3D
+
+// Local memory is host memory, which the C library fills fastest.
+#define __TTL_local_fill(ptr, value, num) memset(ptr, value, num)
+
 #include "../opencl/TTL_import_export.h"
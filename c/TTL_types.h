@@ -25,10 +25,29 @@
 typedef unsigned char uchar;    ///< opencl and so TTL supports a type called uchar which is not part of C
 #define __global                ///< The opencl __global namespace is not supported in C
 #define __local                 ///< The opencl __local namespace is not supported in C
+#define __TTL_SHARED_ADDRESS_SPACE  ///< Internal and external memory are the same, @see TTL_ZERO_COPY_IMPORT
+#if defined(TTL_DMA_MODEL) && !defined(TTL_COPY_ENGINE)
+#define TTL_COPY_ENGINE  ///< The DMA model is a mode of the copy engine, @see TTL_dma_model.h
+#endif
+#ifdef TTL_COPY_ENGINE
+typedef struct __TTL_copy_event *event_t;  ///< A handle to copies issued to the copy engine, @see TTL_copy_engine.h
+#else
 typedef unsigned char event_t;  ///< event_t is not supported, so provide a harmless placeholder
+#endif
 typedef unsigned char uchar;    ///< OpenCL supports uchar so provide the same in c
 typedef unsigned int uint;      ///< OpenCL supports uint so provide the same in c
 typedef unsigned short ushort;  ///< OpenCL supports ushort so provide the same in c
 typedef unsigned long ulong;    ///< OpenCL supports ulong so provide the same in c
 
+#ifndef TTL_GROUP_ID
+#define TTL_GROUP_ID 0          ///< A C kernel runs as a single work-group, unless its caller defines otherwise
+#endif
+#ifndef TTL_NUMBER_OF_GROUPS
+#define TTL_NUMBER_OF_GROUPS 1  ///< A C kernel runs as a single work-group, unless its caller defines otherwise
+#endif
+#define TTL_WORK_ITEM_ID 0            ///< A C work-group is a single work-item
+#define TTL_NUMBER_OF_WORK_ITEMS 1    ///< A C work-group is a single work-item
+#define __TTL_local_barrier()         ///< A single work-item has no other work-items to wait for
+#define __TTL_global_barrier()        ///< A single work-item has no other work-items to wait for
+
 #include "../opencl/TTL_types.h"
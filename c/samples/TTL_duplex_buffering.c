@@ -54,6 +54,13 @@ bool TTL_duplex_buffering(TEST_TENSOR_TYPE *restrict ext_base_in, int external_s
     const TTL_shape_t tensor_shape_out = TTL_create_shape(width, height);
     const TTL_tiler_t output_tiler = TTL_create_tiler(tensor_shape_out, TTL_create_shape(tile_width, tile_height));
 
+    // The tiles processed by this work-group, the input and output tilers have the same number of tiles.
+    const TTL_tile_partition_t input_partition = TTL_create_group_tile_partition(input_tiler, TTL_PARTITION_CONTIGUOUS);
+    const TTL_tile_partition_t output_partition =
+        TTL_create_group_tile_partition(output_tiler, TTL_PARTITION_CONTIGUOUS);
+    TTL_tile_iterator_t input_tiles = TTL_create_partition_tile_iterator(input_tiler, input_partition);
+    TTL_tile_iterator_t output_tiles = TTL_create_partition_tile_iterator(output_tiler, output_partition);
+
     // External layouts.
     const TTL_layout_t ext_layout_in = TTL_create_layout(external_stride_in);
     const TTL_layout_t ext_layout_out = TTL_create_layout(external_stride_out);
@@ -66,17 +73,20 @@ bool TTL_duplex_buffering(TEST_TENSOR_TYPE *restrict ext_base_in, int external_s
     TTL_event_t sb_e_in_out[2] = { TTL_get_event(), TTL_get_event() };
 
     TTL_DUPLEX_BUFFERING_TYPE duplex_scheme = TTL_start_duplex_buffering(
-        ext_input_tensor, l_in, ext_output_tensor, l_out, &sb_e_in_out, TTL_get_tile(0, input_tiler));
+        ext_input_tensor, l_in, ext_output_tensor, l_out, &sb_e_in_out, TTL_current_tile(&input_tiles));
 
-    for (int i = 0; i < TTL_number_of_tiles(input_tiler); ++i) {
-        TTL_tile_t tile_next_import = TTL_get_tile(i, input_tiler);
-        TTL_tile_t tile_current_export = TTL_get_tile(i, output_tiler);
+    for (int i = 0; i < input_partition.number_of_tiles; ++i) {
+        TTL_tile_t tile_next_import = TTL_current_tile(&input_tiles);
+        TTL_tile_t tile_current_export = TTL_current_tile(&output_tiles);
 
         // Import current tile, export previous tile and wait for both transactions.
         TTL_IO_TENSOR_TYPE tensors =
             TTL_step_buffering(&duplex_scheme, tile_next_import, tile_current_export);
 
         compute(tensors.imported_to, tensors.to_export_from);
+
+        TTL_advance_tile_iterator(&input_tiles);
+        TTL_advance_tile_iterator(&output_tiles);
     }
 
     TTL_finish_buffering(&duplex_scheme);
@@ -52,6 +52,13 @@ bool TTL_simplex_buffering(TEST_TENSOR_TYPE *restrict ext_base_in, int external_
     const TTL_shape_t tensor_shape_out = TTL_create_shape(width, height);
     const TTL_tiler_t output_tiler = TTL_create_tiler(tensor_shape_out, TTL_create_shape(tile_width, tile_height));
 
+    // The tiles processed by this work-group, the input and output tilers have the same number of tiles.
+    const TTL_tile_partition_t input_partition = TTL_create_group_tile_partition(input_tiler, TTL_PARTITION_CONTIGUOUS);
+    const TTL_tile_partition_t output_partition =
+        TTL_create_group_tile_partition(output_tiler, TTL_PARTITION_CONTIGUOUS);
+    TTL_tile_iterator_t input_tiles = TTL_create_partition_tile_iterator(input_tiler, input_partition);
+    TTL_tile_iterator_t output_tiles = TTL_create_partition_tile_iterator(output_tiler, output_partition);
+
     // External layouts.
     const TTL_layout_t ext_layout_in = TTL_create_layout(external_stride_in);
     const TTL_layout_t ext_layout_out = TTL_create_layout(external_stride_out);
@@ -68,15 +75,18 @@ bool TTL_simplex_buffering(TEST_TENSOR_TYPE *restrict ext_base_in, int external_
                                                                          ext_output_tensor,
                                                                          &tb_e_in,
                                                                          &tb_e_out,
-                                                                         TTL_get_tile(0, input_tiler));
+                                                                         TTL_current_tile(&input_tiles));
 
-    for (int i = 0; i < TTL_number_of_tiles(input_tiler); ++i) {
-        TTL_tile_t tile_next_import = TTL_get_tile(i + 1, input_tiler);
-        TTL_tile_t tile_current_export = TTL_get_tile(i, output_tiler);
+    for (int i = 0; i < input_partition.number_of_tiles; ++i) {
+        TTL_tile_t tile_next_import = TTL_look_ahead_tile(&input_tiles);
+        TTL_tile_t tile_current_export = TTL_current_tile(&output_tiles);
 
         TTL_IO_TENSOR_TYPE tensors = TTL_step_buffering(&simplex_scheme, tile_next_import, tile_current_export);
 
         compute(tensors.imported_to, tensors.to_export_from);
+
+        TTL_advance_tile_iterator(&input_tiles);
+        TTL_advance_tile_iterator(&output_tiles);
     }
 
     TTL_finish_buffering(&simplex_scheme);
@@ -0,0 +1,141 @@
+/*
+ * copy_benchmark.c
+ *
+ * Copyright (c) 2023 Mobileye
+ *
+ * Licensed under the Apache License, Version 2.0 (the License);
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+/*
+ * Compare the row copy kernels used by the C target's async_work_group_copy_3D3D
+ * against a call to memcpy per line.
+ *
+ *     clang -O2 -I $TTL_INCLUDE_PATH -DTTL_TARGET=c copy_benchmark.c -o copy_benchmark
+ *
+ * For each row length a tile of TILE_LINES lines is repeatedly copied out of a wider
+ * tensor, the time per line is reported for both and the results are checked to match.
+ *
+ * Where non-temporal stores are available the bandwidth of exporting large tiles to an
+ * image much bigger than the cache is then compared with and without streaming stores.
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "TTL/TTL.h"
+
+#define TENSOR_LINE_BYTES 1024
+#define TILE_LINES 256
+#define REPEATS 20000
+
+#define IMAGE_BYTES (256 * 1024 * 1024)
+#define EXPORT_TILE_BYTES (1024 * 1024)
+#define EXPORT_TILE_LINE_BYTES 4096
+
+static uchar src_buffer[TILE_LINES * TENSOR_LINE_BYTES];
+static uchar dst_buffer[TILE_LINES * TENSOR_LINE_BYTES];
+static uchar check_buffer[TILE_LINES * TENSOR_LINE_BYTES];
+
+static double now(void) {
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (ts.tv_sec * 1e9) + ts.tv_nsec;
+}
+
+static double time_kernel(const __TTL_copy_rows_kernel_t kernel, uchar *const dst, const size_t row_bytes) {
+    const double start = now();
+
+    for (int repeat = 0; repeat < REPEATS; repeat++) {
+        kernel(dst, src_buffer, row_bytes, TILE_LINES, 1, TENSOR_LINE_BYTES, 0, row_bytes, 0);
+        // Stop the compiler treating the repeats as redundant
+        __asm__ volatile("" : : "r"(dst) : "memory");
+    }
+
+    return (now() - start) / (REPEATS * (double)TILE_LINES);
+}
+
+#ifdef __TTL_stream_store
+static double export_bandwidth(const __TTL_copy_rows_kernel_t kernel, uchar *const image, const uchar *const tile) {
+    const size_t tile_lines = EXPORT_TILE_BYTES / EXPORT_TILE_LINE_BYTES;
+    const double start = now();
+
+    for (size_t offset = 0; offset < IMAGE_BYTES; offset += EXPORT_TILE_BYTES) {
+        kernel(image + offset, tile, EXPORT_TILE_LINE_BYTES, tile_lines, 1, EXPORT_TILE_LINE_BYTES, 0,
+               EXPORT_TILE_LINE_BYTES, 0);
+    }
+
+    return IMAGE_BYTES / (now() - start);
+}
+
+static void compare_streaming(void) {
+    uchar *const image = malloc(IMAGE_BYTES);
+    uchar *const tile = malloc(EXPORT_TILE_BYTES);
+
+    if ((image == NULL) || (tile == NULL)) return;
+
+    memset(tile, 1, EXPORT_TILE_BYTES);
+
+    // Warm up both so that neither measurement includes first touch costs
+    export_bandwidth(__TTL_copy_rows_kernel(EXPORT_TILE_LINE_BYTES), image, tile);
+    export_bandwidth(__TTL_copy_rows_streaming_kernel(EXPORT_TILE_LINE_BYTES), image, tile);
+
+    const double cached = export_bandwidth(__TTL_copy_rows_kernel(EXPORT_TILE_LINE_BYTES), image, tile);
+    const double streamed = export_bandwidth(__TTL_copy_rows_streaming_kernel(EXPORT_TILE_LINE_BYTES), image, tile);
+
+    printf("\nExporting %d MiB in %d KiB tiles: cached %.2f GB/s, streaming %.2f GB/s\n",
+           IMAGE_BYTES / (1024 * 1024),
+           EXPORT_TILE_BYTES / 1024,
+           cached,
+           streamed);
+
+    free(image);
+    free(tile);
+}
+#endif
+
+int main(void) {
+    static const size_t row_lengths[] = { 1, 2, 3, 4, 6, 8, 12, 16, 20, 24, 32, 40, 48, 64, 80, 100, 127, 128, 256 };
+    int result = EXIT_SUCCESS;
+
+    for (size_t i = 0; i < sizeof(src_buffer); i++) src_buffer[i] = rand();
+
+    printf("%10s %14s %14s %8s\n", "row bytes", "memcpy ns/row", "kernel ns/row", "speedup");
+
+    for (size_t i = 0; i < sizeof(row_lengths) / sizeof(row_lengths[0]); i++) {
+        const size_t row_bytes = row_lengths[i];
+        const double memcpy_ns = time_kernel(__TTL_copy_rows_memcpy, check_buffer, row_bytes);
+        const double kernel_ns = time_kernel(__TTL_copy_rows_kernel(row_bytes), dst_buffer, row_bytes);
+        const bool match = memcmp(dst_buffer, check_buffer, row_bytes * TILE_LINES) == 0;
+
+        printf("%10zu %14.2f %14.2f %7.2fx%s\n",
+               row_bytes,
+               memcpy_ns,
+               kernel_ns,
+               memcpy_ns / kernel_ns,
+               match ? "" : " MISMATCH");
+
+        if (match == false) result = EXIT_FAILURE;
+    }
+
+#ifdef __TTL_stream_store
+    compare_streaming();
+#endif
+
+    return result;
+}
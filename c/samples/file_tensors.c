@@ -0,0 +1,200 @@
+/*
+ * file_tensors.c
+ *
+ * Copyright (c) 2023 Mobileye
+ *
+ * Licensed under the Apache License, Version 2.0 (the License);
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Tile an image held in a file, writing the result to a second file, using
+ * the C target's file backed external memory.
+ *
+ *     clang -O2 -I $TTL_INCLUDE_PATH -DTTL_TARGET=c -DTTL_FILE_TENSORS -DTTL_COPY_ENGINE -pthread file_tensors.c -o file_tensors
+ *     ./file_tensors [directory]
+ *
+ * The input is created in the directory given (default /tmp), then each tile is
+ * imported, inverted and exported with double buffering, first with the files attached
+ * by TTL_attach_file and then mapped by TTL_map_file. The kernel code is the same as for
+ * an image in memory, only the creation of the base addresses differs.
+ *
+ * The input is dropped from the page cache before each run where the system allows, so
+ * the times include reading it from the disk.
+ */
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "TTL/TTL.h"
+
+#define IMAGE_WIDTH 4000
+#define IMAGE_HEIGHT 3000
+#define TILE_WIDTH 500
+#define TILE_HEIGHT 250
+
+static uchar input_buffer_1[TILE_WIDTH * TILE_HEIGHT];
+static uchar input_buffer_2[TILE_WIDTH * TILE_HEIGHT];
+static uchar output_buffer_1[TILE_WIDTH * TILE_HEIGHT];
+static uchar output_buffer_2[TILE_WIDTH * TILE_HEIGHT];
+
+static uchar line[IMAGE_WIDTH];
+
+static double now(void) {
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return ts.tv_sec + (ts.tv_nsec * 1e-9);
+}
+
+static uchar pixel(const int x, const int y) {
+    return (uchar)((x * 7) + (y * 13));
+}
+
+static void compute(const TTL_int_uchar_sub_tensor_t tensor_in, const TTL_int_uchar_sub_tensor_t tensor_out) {
+    for (TTL_dim_t y = 0; y < tensor_out.tensor.shape.height; ++y) {
+        for (TTL_dim_t x = 0; x < tensor_out.tensor.shape.width; ++x) {
+            TTL_write_tensor(tensor_out, (uchar)(255 - TTL_read_tensor(tensor_in, x, y)), x, y);
+        }
+    }
+}
+
+static void invert(uchar *const ext_base_in, uchar *const ext_base_out) {
+    const TTL_shape_t image_shape = TTL_create_shape(IMAGE_WIDTH, IMAGE_HEIGHT);
+    const TTL_tiler_t tiler = TTL_create_tiler(image_shape, TTL_create_shape(TILE_WIDTH, TILE_HEIGHT));
+    const TTL_layout_t ext_layout = TTL_create_layout(IMAGE_WIDTH, IMAGE_WIDTH * IMAGE_HEIGHT);
+
+    const TTL_const_ext_uchar_tensor_t ext_input_tensor =
+        TTL_create_const_ext_tensor(ext_base_in, image_shape, ext_layout);
+    const TTL_ext_uchar_tensor_t ext_output_tensor = TTL_create_ext_tensor(ext_base_out, image_shape, ext_layout);
+
+    TTL_event_t import_DB_e = TTL_get_event();
+    TTL_import_double_const_uchar_tensor_buffering_t import_db = TTL_start_import_double_buffering(
+        input_buffer_1, input_buffer_2, ext_input_tensor, &import_DB_e, TTL_get_tile(0, tiler));
+
+    TTL_event_t export_DB_e = TTL_get_event();
+    TTL_export_double_const_uchar_tensor_buffering_t export_db =
+        TTL_start_export_double_buffering(output_buffer_1, output_buffer_2, ext_output_tensor, &export_DB_e);
+
+    for (int i = 0; i < TTL_number_of_tiles(tiler); ++i) {
+        TTL_int_uchar_sub_tensor_t imported_to = TTL_step_buffering(&import_db, TTL_get_tile(i + 1, tiler));
+        TTL_int_uchar_sub_tensor_t exported_from = TTL_step_buffering(&export_db, TTL_get_tile(i, tiler));
+
+        compute(imported_to, exported_from);
+    }
+
+    TTL_finish_buffering(&import_db);
+    TTL_finish_buffering(&export_db);
+}
+
+static int open_file(const char *const directory, const char *const name) {
+    char path[4096];
+
+    snprintf(path, sizeof(path), "%s/%s", directory, name);
+
+    const int fd = open(path, O_RDWR | O_CREAT | O_TRUNC, 0600);
+
+    if (fd < 0) {
+        perror(path);
+        exit(1);
+    }
+
+    unlink(path);
+
+    return fd;
+}
+
+static int check_output(const int output_fd) {
+    for (int y = 0; y < IMAGE_HEIGHT; y++) {
+        if (pread(output_fd, line, IMAGE_WIDTH, (off_t)y * IMAGE_WIDTH) != IMAGE_WIDTH) {
+            perror("pread");
+            return 1;
+        }
+
+        for (int x = 0; x < IMAGE_WIDTH; x++) {
+            if (line[x] != (uchar)(255 - pixel(x, y))) {
+                printf("Mismatch at [%d, %d] %d != %d\n", x, y, line[x], (uchar)(255 - pixel(x, y)));
+                return 1;
+            }
+        }
+    }
+
+    return 0;
+}
+
+static int run(const char *const name, const bool map, const int input_fd, const int output_fd) {
+    const size_t image_bytes = (size_t)IMAGE_WIDTH * IMAGE_HEIGHT;
+
+    fdatasync(input_fd);
+    posix_fadvise(input_fd, 0, image_bytes, POSIX_FADV_DONTNEED);
+
+    const double start = now();
+    uchar *const ext_base_in =
+        (uchar *)(map ? TTL_map_file(input_fd, 0, image_bytes, false) : TTL_attach_file(input_fd, 0, image_bytes));
+    uchar *const ext_base_out =
+        (uchar *)(map ? TTL_map_file(output_fd, 0, image_bytes, true) : TTL_attach_file(output_fd, 0, image_bytes));
+
+    if ((ext_base_in == NULL) || (ext_base_out == NULL)) {
+        printf("Unable to %s the files\n", name);
+        return 1;
+    }
+
+    invert(ext_base_in, ext_base_out);
+
+    const int input_error = TTL_detach_file(ext_base_in);
+    const int output_error = TTL_detach_file(ext_base_out);
+    const double seconds = now() - start;
+
+    if ((input_error != 0) || (output_error != 0)) {
+        printf("Transfer failed: %s\n", strerror(input_error != 0 ? input_error : output_error));
+        return 1;
+    }
+
+    if (check_output(output_fd) != 0) return 1;
+
+    printf("%dx%d image inverted through %s files in %.1f ms\n", IMAGE_WIDTH, IMAGE_HEIGHT, name, seconds * 1e3);
+
+    return 0;
+}
+
+int main(int argc, char *argv[]) {
+    const char *const directory = (argc > 1) ? argv[1] : "/tmp";
+    const int input_fd = open_file(directory, "ttl_file_tensors_in.bin");
+    const int output_fd = open_file(directory, "ttl_file_tensors_out.bin");
+
+    for (int y = 0; y < IMAGE_HEIGHT; y++) {
+        for (int x = 0; x < IMAGE_WIDTH; x++) line[x] = pixel(x, y);
+
+        if (pwrite(input_fd, line, IMAGE_WIDTH, (off_t)y * IMAGE_WIDTH) != IMAGE_WIDTH) {
+            perror("pwrite");
+            return 1;
+        }
+    }
+
+    // The mapped output must already have its full size.
+    if (ftruncate(output_fd, (off_t)IMAGE_WIDTH * IMAGE_HEIGHT) != 0) {
+        perror("ftruncate");
+        return 1;
+    }
+
+    const int result = run("attached", false, input_fd, output_fd) || run("mapped", true, input_fd, output_fd);
+
+    close(input_fd);
+    close(output_fd);
+
+    return result;
+}
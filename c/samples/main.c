@@ -20,10 +20,18 @@
 #include <stdio.h>
 #include <stdbool.h>
 
+#ifndef TENSOR_WIDTH
 #define TENSOR_WIDTH 103
+#endif
+#ifndef TENSOR_HEIGHT
 #define TENSOR_HEIGHT 27
+#endif
+#ifndef TILE_WIDTH
 #define TILE_WIDTH 1
+#endif
+#ifndef TILE_HEIGHT
 #define TILE_HEIGHT 1
+#endif
 
 #include "TTL/TTL.h"
 #include "kernel.h"
@@ -50,4 +58,8 @@ int main(void) {
                     TILE_HEIGHT) == true) {
         printf("Compute checked and successful\n");
     }
+
+#ifdef TTL_DMA_MODEL
+    TTL_dma_model_print();
+#endif
 }
\ No newline at end of file
@@ -0,0 +1,501 @@
+/*
+ * TTL_compressed_import_export.h
+ *
+ * Copyright (c) 2023 Mobileye
+ *
+ * Licensed under the Apache License, Version 2.0 (the License);
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file
+ *
+ * External tensors held compressed, decoded as they are imported and encoded as they are exported.
+ *
+ * Each line of the tensor is divided into blocks of block_width elements that are encoded
+ * independently, and an index holds the byte offset at which each block starts. A tile is
+ * imported by decoding only the blocks it covers, so tiles can be taken in any order.
+ *
+ * A block is a sequence of packets, each beginning with a header byte. A header below 128 is
+ * followed by header + 1 elements held unchanged. A header of 128 or above is a run of
+ * header - 127 equal elements, which for TTL_COMPRESSION_ZERO_RUN are zero and for
+ * TTL_COMPRESSION_RLE are the single element following the header. Packets never span blocks.
+ *
+ * Example:
+ * @code
+ * // Compress a label map once, then import tiles of it.
+ * TTL_compressed_ext_tensor_t labels = TTL_create_compressed_ext_tensor(
+ *     data, index, TTL_create_shape(width, height), sizeof(uchar), 64, TTL_COMPRESSION_RLE);
+ * TTL_compress_tensor(labels, ext_label_tensor);
+ *
+ * TTL_import_compressed(int_label_tensor, labels, tile.offset, &event);
+ * @endcode
+ */
+
+#pragma once
+
+// This file presumes that the following have been pre included.
+// this is not done here for path reasons.
+// #include "TTL_import_export.h"
+#include "../TTL_macros.h"
+#include "../TTL_types.h"
+
+/**
+ * @def TTL_COMPRESSED_BLOCK_BYTES
+ *
+ * @brief The most bytes the elements of a block of a compressed tensor may take.
+ *
+ * Blocks are encoded a block at a time from private memory, of this many bytes.
+ */
+#ifndef TTL_COMPRESSED_BLOCK_BYTES
+#define TTL_COMPRESSED_BLOCK_BYTES 256
+#endif
+
+/**
+ * @def __TTL_PACKET_RUN
+ *
+ * @brief Set in the header of a packet that is a run, @see TTL_compressed_import_export.h
+ */
+#define __TTL_PACKET_RUN 0x80
+
+/**
+ * @def __TTL_PACKET_MAX
+ *
+ * @brief The most elements a packet holds.
+ */
+#define __TTL_PACKET_MAX 128
+
+/**
+ * @brief How the blocks of a compressed tensor are encoded
+ */
+typedef enum {
+    TTL_COMPRESSION_ZERO_RUN,  ///< Runs of zero elements are encoded, suited to sparse masks
+    TTL_COMPRESSION_RLE        ///< Runs of any equal elements are encoded, suited to label maps
+} TTL_compression_t;
+
+/**
+ * @brief Description of an external tensor held compressed
+ *
+ * The index has an entry for each block, ordered by block within a line, then by line, then by
+ * plane. @see TTL_compressed_import_export.h for the encoding.
+ */
+typedef struct {
+    TTL_global(void *) data;        ///< The encoded blocks
+    TTL_global(ulong *) index;      ///< The byte offset in data at which each block starts
+    TTL_shape_t shape;              ///< The shape of the decoded tensor
+    TTL_dim_t elem_size;            ///< The size of the decoded elements
+    TTL_dim_t block_width;          ///< The number of elements of a line in each block
+    TTL_compression_t compression;  ///< How the blocks are encoded
+} TTL_compressed_ext_tensor_t;
+
+/**
+ * @brief Create a TTL_compressed_ext_tensor_t
+ *
+ * A block whose elements would take more than TTL_COMPRESSED_BLOCK_BYTES cannot be encoded, so
+ * for such a block_width, or a block_width or elem_size of 0, an empty tensor with no blocks is
+ * returned, which imports and exports nothing.
+ *
+ * @param data The encoded blocks, or where they are to be written.
+ * @param index The offset of each block, or where it is to be written, @see TTL_compressed_index_size
+ * @param shape The shape of the decoded tensor.
+ * @param elem_size The size of the decoded elements.
+ * @param block_width The number of elements of a line in each block, whose elements take at most
+ * TTL_COMPRESSED_BLOCK_BYTES.
+ * @param compression How the blocks are encoded.
+ */
+static inline TTL_compressed_ext_tensor_t TTL_create_compressed_ext_tensor(
+    TTL_global(void *) data, TTL_global(ulong *) index, const TTL_shape_t shape, const TTL_dim_t elem_size,
+    const TTL_dim_t block_width, const TTL_compression_t compression) {
+    TTL_compressed_ext_tensor_t result;
+
+    result.data = data;
+    result.index = index;
+    result.shape = shape;
+    result.elem_size = elem_size;
+    result.block_width = block_width;
+    result.compression = compression;
+
+    if ((elem_size == 0) || (block_width == 0) || (((size_t)block_width * elem_size) > TTL_COMPRESSED_BLOCK_BYTES)) {
+        // A width of one keeps the number of blocks of each line, 0, well defined.
+        result.shape = TTL_create_shape(0, 0, 0);
+        result.block_width = 1;
+    }
+
+    return result;
+}
+
+/**
+ * @brief Return the number of blocks in each line of a compressed tensor
+ */
+static inline TTL_dim_t TTL_compressed_blocks_per_line(const TTL_compressed_ext_tensor_t tensor) {
+    return (tensor.shape.width + tensor.block_width - 1) / tensor.block_width;
+}
+
+/**
+ * @brief Return the number of entries in the index of a compressed tensor
+ */
+static inline size_t TTL_compressed_index_size(const TTL_compressed_ext_tensor_t tensor) {
+    return (size_t)TTL_compressed_blocks_per_line(tensor) * tensor.shape.height * tensor.shape.depth;
+}
+
+/**
+ * @brief Return the most bytes a block of a compressed tensor can be encoded in
+ *
+ * A run is only encoded where it is smaller than the elements it replaces by at least the header
+ * of the packet that follows it, so only the first header of a block and the headers splitting
+ * elements into packets of __TTL_PACKET_MAX are added to the elements themselves.
+ */
+static inline size_t TTL_compressed_block_capacity(const TTL_compressed_ext_tensor_t tensor) {
+    return ((size_t)tensor.block_width * tensor.elem_size) + (tensor.block_width / __TTL_PACKET_MAX) + 1;
+}
+
+/**
+ * @brief Return the most bytes the data of a compressed tensor can take
+ */
+static inline size_t TTL_compressed_capacity(const TTL_compressed_ext_tensor_t tensor) {
+    return TTL_compressed_index_size(tensor) * TTL_compressed_block_capacity(tensor);
+}
+
+/**
+ * @brief Return the number of elements held by a block of a compressed tensor, the last block of a line being shorter.
+ */
+static inline size_t __TTL_compressed_block_length(const TTL_compressed_ext_tensor_t tensor, const TTL_dim_t block) {
+    const size_t block_start = (size_t)block * tensor.block_width;
+
+    return TTL_MIN(tensor.shape.width - block_start, (size_t)tensor.block_width);
+}
+
+/**
+ * @def __TTL_create_decode_block
+ *
+ * @brief Create a function decoding elements first to first + count of a block to dst_pointer memory.
+ */
+#define __TTL_create_decode_block(name, dst_pointer)                                                             \
+    static inline void name(dst_pointer const dst,                                                                \
+                            TTL_global(const uchar *) src,                                                       \
+                            const size_t first,                                                                  \
+                            const size_t count,                                                                  \
+                            const size_t elem_size,                                                              \
+                            const TTL_compression_t compression) {                                               \
+        const size_t end = first + count;                                                                        \
+                                                                                                                 \
+        for (size_t position = 0; position < end;) {                                                             \
+            const uchar header = *src++;                                                                         \
+            const bool run = header >= __TTL_PACKET_RUN;                                                         \
+            const size_t length = (header & (__TTL_PACKET_RUN - 1)) + 1;                                         \
+            const bool zero = run && (compression == TTL_COMPRESSION_ZERO_RUN);                                  \
+                                                                                                                 \
+            for (size_t element = TTL_MAX(position, first); element < TTL_MIN(position + length, end);           \
+                 element++) {                                                                                    \
+                for (size_t byte = 0; byte < elem_size; byte++) {                                                \
+                    dst[((element - first) * elem_size) + byte] =                                                \
+                        zero  ? 0                                                                                \
+                        : run ? src[byte]                                                                        \
+                              : src[((element - position) * elem_size) + byte];                                  \
+                }                                                                                                \
+            }                                                                                                    \
+                                                                                                                 \
+            src += zero ? 0 : run ? elem_size : length * elem_size;                                              \
+            position += length;                                                                                  \
+        }                                                                                                        \
+    }
+
+__TTL_create_decode_block(__TTL_decode_block_local, TTL_local(uchar *));
+__TTL_create_decode_block(__TTL_decode_block_private, uchar *);
+
+/**
+ * @brief Return the number of elements from the start of src equal to its first, at most __TTL_PACKET_MAX.
+ *
+ * For TTL_COMPRESSION_ZERO_RUN only runs of zero are counted, so 0 is returned where the first element is not zero.
+ */
+static inline size_t __TTL_encode_run_length(const uchar *const src, const size_t count, const size_t elem_size,
+                                             const TTL_compression_t compression) {
+    const size_t limit = TTL_MIN(count, (size_t)__TTL_PACKET_MAX);
+    size_t length = 0;
+
+    for (; length < limit; length++) {
+        for (size_t byte = 0; byte < elem_size; byte++) {
+            const uchar expected = (compression == TTL_COMPRESSION_ZERO_RUN) ? 0 : src[byte];
+
+            if (src[(length * elem_size) + byte] != expected) return length;
+        }
+    }
+
+    return length;
+}
+
+/**
+ * @brief Write a packet of literal elements, returning the bytes written
+ */
+static inline size_t __TTL_encode_literal(TTL_global(uchar *) const dst, const uchar *const src, const size_t count,
+                                          const size_t elem_size) {
+    dst[0] = (uchar)(count - 1);
+
+    for (size_t byte = 0; byte < (count * elem_size); byte++) dst[1 + byte] = src[byte];
+
+    return 1 + (count * elem_size);
+}
+
+/**
+ * @brief Encode count elements from private memory as a block, returning the bytes written
+ *
+ * A run is encoded where it saves at least a byte over holding its elements unchanged after
+ * paying for the header of the packet that follows it, @see TTL_compressed_block_capacity
+ */
+static inline size_t __TTL_encode_block(TTL_global(uchar *) const dst, const uchar *const src, const size_t count,
+                                        const size_t elem_size, const TTL_compression_t compression) {
+    const size_t run_bytes = 1 + ((compression == TTL_COMPRESSION_ZERO_RUN) ? 0 : elem_size);
+    size_t written = 0;
+    size_t literal_start = 0;
+    size_t element = 0;
+
+    while (element < count) {
+        const size_t run =
+            __TTL_encode_run_length(src + (element * elem_size), count - element, elem_size, compression);
+
+        if ((run * elem_size) >= (run_bytes + 1)) {
+            if (element > literal_start) {
+                written += __TTL_encode_literal(
+                    dst + written, src + (literal_start * elem_size), element - literal_start, elem_size);
+            }
+
+            dst[written] = (uchar)(__TTL_PACKET_RUN | (run - 1));
+            for (size_t byte = 1; byte < run_bytes; byte++) dst[written + byte] = src[(element * elem_size) + byte - 1];
+            written += run_bytes;
+
+            element += run;
+            literal_start = element;
+        } else {
+            element++;
+
+            if ((element - literal_start) == __TTL_PACKET_MAX) {
+                written += __TTL_encode_literal(
+                    dst + written, src + (literal_start * elem_size), __TTL_PACKET_MAX, elem_size);
+                literal_start = element;
+            }
+        }
+    }
+
+    if (count > literal_start) {
+        written +=
+            __TTL_encode_literal(dst + written, src + (literal_start * elem_size), count - literal_start, elem_size);
+    }
+
+    return written;
+}
+
+/**
+ * @brief Return the encoded data of a block of a compressed tensor
+ */
+static inline TTL_global(uchar *)
+    __TTL_compressed_block(const TTL_compressed_ext_tensor_t tensor, const TTL_offset_dim_t line,
+                           const TTL_offset_dim_t plane, const TTL_dim_t block) {
+    const size_t entry =
+        ((((size_t)plane * tensor.shape.height) + line) * TTL_compressed_blocks_per_line(tensor)) + block;
+
+    return (TTL_global(uchar *))tensor.data + tensor.index[entry];
+}
+
+/**
+ * @brief Import a tile of a compressed external tensor to an internal tensor
+ *
+ * Only the blocks the tile covers are decoded, and of the first and last only the elements within
+ * the tile. The import is synchronous: the lines of the tile are divided between the work-items,
+ * which each decode their own lines from external memory, and the tile is complete in every
+ * work-item on return. The decode therefore does not overlap compute and the event is unchanged.
+ * Elements of the internal tensor outside of the external tensor are left unchanged.
+ *
+ * @param internal_tensor A TTL_int_tensor_t describing the internal tensor, with the element size
+ * of the external tensor.
+ * @param external_tensor The compressed tensor imported from.
+ * @param offset The offset in the external tensor of the tile, for example the offset of a TTL_tile_t.
+ * @param event A pointer to the event which describes the transfer.
+ */
+static inline void __TTL_TRACE_FN(TTL_import_compressed_base, const TTL_int_tensor_t internal_tensor,
+                                  const TTL_compressed_ext_tensor_t external_tensor, const TTL_offset_t offset,
+                                  TTL_event_t *const event) {
+    TTL_offset_t begin;
+    TTL_offset_t end;
+
+    __TTL_sub_tensor_inside(internal_tensor.shape, external_tensor.shape, offset, &begin, &end);
+
+    const size_t lines = (size_t)(end.y - begin.y) * (end.z - begin.z);
+
+    for (size_t tile_line = TTL_WORK_ITEM_ID; tile_line < lines; tile_line += TTL_NUMBER_OF_WORK_ITEMS) {
+        const TTL_offset_dim_t line = begin.y + (tile_line % (end.y - begin.y));
+        const TTL_offset_dim_t plane = begin.z + (tile_line / (end.y - begin.y));
+
+        for (TTL_offset_dim_t x = begin.x; x < end.x;) {
+            const size_t ext_x = offset.x + x;
+            const TTL_dim_t block = ext_x / external_tensor.block_width;
+            const size_t first = ext_x - ((size_t)block * external_tensor.block_width);
+            const size_t count = TTL_MIN(external_tensor.block_width - first, (size_t)(end.x - x));
+
+            __TTL_decode_block_local(
+                (TTL_local(uchar *))internal_tensor.base +
+                    (TTL_linearize(TTL_create_offset(x, line, plane), internal_tensor.layout) *
+                     external_tensor.elem_size),
+                __TTL_compressed_block(external_tensor, offset.y + line, offset.z + plane, block),
+                first,
+                count,
+                external_tensor.elem_size,
+                external_tensor.compression);
+
+            x += count;
+        }
+    }
+
+    // The tile is complete, and seen by every work-item, on return.
+    __TTL_local_barrier();
+
+    (void)event;
+}
+
+/**
+ * @brief Export an internal tensor to a tile of a compressed external tensor
+ *
+ * Each block the tile covers is encoded again in place. Where the tile covers only part of a
+ * block the block is first decoded, so tiles sharing a block must not be exported concurrently.
+ * The export is synchronous: the lines of the tile are divided between the work-items, so each
+ * block is encoded by the one work-item whose line it is in, and the blocks are complete on
+ * return. The event is unchanged.
+ *
+ * A block encoded again may grow, so the external tensor must have been laid out by
+ * TTL_reserve_compressed_tensor rather than TTL_compress_tensor.
+ *
+ * @param internal_tensor A TTL_const_int_tensor_t describing the internal tensor, with the element
+ * size of the external tensor.
+ * @param external_tensor The compressed tensor exported to.
+ * @param offset The offset in the external tensor of the tile, for example the offset of a TTL_tile_t.
+ * @param event A pointer to the event which describes the transfer.
+ */
+static inline void __TTL_TRACE_FN(TTL_export_compressed_base, const TTL_const_int_tensor_t internal_tensor,
+                                  const TTL_compressed_ext_tensor_t external_tensor, const TTL_offset_t offset,
+                                  TTL_event_t *const event) {
+    const size_t elem_size = external_tensor.elem_size;
+    uchar block_elements[TTL_COMPRESSED_BLOCK_BYTES];
+    TTL_offset_t begin;
+    TTL_offset_t end;
+
+    __TTL_sub_tensor_inside(internal_tensor.shape, external_tensor.shape, offset, &begin, &end);
+
+    const size_t lines = (size_t)(end.y - begin.y) * (end.z - begin.z);
+
+    for (size_t tile_line = TTL_WORK_ITEM_ID; tile_line < lines; tile_line += TTL_NUMBER_OF_WORK_ITEMS) {
+        const TTL_offset_dim_t line = begin.y + (tile_line % (end.y - begin.y));
+        const TTL_offset_dim_t plane = begin.z + (tile_line / (end.y - begin.y));
+
+        for (TTL_offset_dim_t x = begin.x; x < end.x;) {
+            const size_t ext_x = offset.x + x;
+            const TTL_dim_t block = ext_x / external_tensor.block_width;
+            const size_t first = ext_x - ((size_t)block * external_tensor.block_width);
+            const size_t count = TTL_MIN(external_tensor.block_width - first, (size_t)(end.x - x));
+            const size_t block_length = __TTL_compressed_block_length(external_tensor, block);
+            TTL_global(uchar *) const encoded =
+                __TTL_compressed_block(external_tensor, offset.y + line, offset.z + plane, block);
+            TTL_local(const uchar *) const elements =
+                (TTL_local(const uchar *))internal_tensor.base +
+                (TTL_linearize(TTL_create_offset(x, line, plane), internal_tensor.layout) * elem_size);
+
+            if (count != block_length) {
+                __TTL_decode_block_private(
+                    block_elements, encoded, 0, block_length, elem_size, external_tensor.compression);
+            }
+
+            for (size_t byte = 0; byte < (count * elem_size); byte++) {
+                block_elements[(first * elem_size) + byte] = elements[byte];
+            }
+
+            __TTL_encode_block(encoded, block_elements, block_length, elem_size, external_tensor.compression);
+
+            x += count;
+        }
+    }
+
+    // The blocks are complete, and seen by every work-item, on return.
+    __TTL_global_barrier();
+
+    (void)event;
+}
+
+/**
+ * @brief Lay out a compressed tensor so that it can be exported to, holding zero in every element
+ *
+ * Each block is given TTL_compressed_block_capacity bytes, so can be encoded again in place by
+ * TTL_export_compressed.
+ *
+ * @param tensor The compressed tensor, whose data holds at least TTL_compressed_capacity bytes and
+ * whose index holds TTL_compressed_index_size entries.
+ *
+ * @return The number of bytes of data used.
+ */
+static inline size_t TTL_reserve_compressed_tensor(const TTL_compressed_ext_tensor_t tensor) {
+    const uchar zero_elements[TTL_COMPRESSED_BLOCK_BYTES] = { 0 };
+    const TTL_dim_t blocks_per_line = TTL_compressed_blocks_per_line(tensor);
+    const size_t block_capacity = TTL_compressed_block_capacity(tensor);
+    const size_t index_size = TTL_compressed_index_size(tensor);
+
+    for (size_t entry = 0; entry < index_size; entry++) {
+        tensor.index[entry] = (ulong)(entry * block_capacity);
+        __TTL_encode_block((TTL_global(uchar *))tensor.data + tensor.index[entry],
+                           zero_elements,
+                           __TTL_compressed_block_length(tensor, entry % blocks_per_line),
+                           tensor.elem_size,
+                           tensor.compression);
+    }
+
+    return index_size * block_capacity;
+}
+
+/**
+ * @brief Compress an external tensor, writing the blocks one after another
+ *
+ * Typically used once on the host to prepare an input. The result is as small as the encoding
+ * allows, so can be imported from but not exported to.
+ *
+ * @param compressed The compressed tensor written, with the shape and element size of tensor, whose
+ * data holds at least TTL_compressed_capacity bytes and whose index holds TTL_compressed_index_size entries.
+ * @param tensor The tensor compressed.
+ *
+ * @return The number of bytes of data used.
+ */
+static inline size_t TTL_compress_tensor_base(const TTL_compressed_ext_tensor_t compressed,
+                                              const TTL_const_ext_tensor_t tensor) {
+    const size_t elem_size = compressed.elem_size;
+    const TTL_dim_t blocks_per_line = TTL_compressed_blocks_per_line(compressed);
+    uchar block_elements[TTL_COMPRESSED_BLOCK_BYTES];
+    size_t written = 0;
+    size_t entry = 0;
+
+    for (TTL_dim_t plane = 0; plane < compressed.shape.depth; plane++) {
+        for (TTL_dim_t line = 0; line < compressed.shape.height; line++) {
+            for (TTL_dim_t block = 0; block < blocks_per_line; block++) {
+                const size_t block_length = __TTL_compressed_block_length(compressed, block);
+                TTL_global(const uchar *) const elements =
+                    (TTL_global(const uchar *))tensor.base +
+                    (TTL_linearize(TTL_create_offset(block * compressed.block_width, line, plane), tensor.layout) *
+                     elem_size);
+
+                for (size_t byte = 0; byte < (block_length * elem_size); byte++) block_elements[byte] = elements[byte];
+
+                compressed.index[entry++] = (ulong)written;
+                written += __TTL_encode_block((TTL_global(uchar *))compressed.data + written,
+                                              block_elements,
+                                              block_length,
+                                              elem_size,
+                                              compressed.compression);
+            }
+        }
+    }
+
+    return written;
+}
@@ -0,0 +1,187 @@
+/*
+ * TTL_converting_import_export.h
+ *
+ * Copyright (c) 2023 Mobileye
+ *
+ * Licensed under the Apache License, Version 2.0 (the License);
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+// This file presumes that the following have been pre included.
+// this is not done here for path reasons.
+// #include "TTL_import_export.h"
+#include "../TTL_macros.h"
+#include "../TTL_types.h"
+
+/**
+ * @brief Begin the import of an external tensor to an internal sub tensor converting each element
+ *
+ * As TTL_import_sub_tensor the parts of the sub tensor outside of the external tensor are filled
+ * as its boundary describes. A converted tile is always copied, even where TTL_ZERO_COPY_IMPORT is defined.
+ *
+ * @param internal_sub_tensor A TTL_int_sub_tensor_t describing the internal tensor.
+ * @param const_external_tensor A TTL_const_ext_tensor_t describing the external tensor.
+ * @param conversion The conversion applied to each element, @see TTL_import_convert_base
+ * @param event A pointer to the event which describes the transfer.
+ * @param padding_cache The padding last written to the internal buffer, @see TTL_import_pre_fill_cached
+ */
+static inline void __TTL_TRACE_FN(TTL_import_convert_sub_tensor_base, const TTL_int_sub_tensor_t internal_sub_tensor,
+                                  const TTL_const_ext_tensor_t const_external_tensor,
+                                  const TTL_conversion_t conversion, TTL_event_t *const event,
+                                  TTL_padding_cache_t *const padding_cache) {
+    TTL_local(void *) dst_address;
+    TTL_global(void *) src_address;
+
+    if (TTL_conversion_empty(conversion)) {
+        TTL_import_sub_tensor(internal_sub_tensor, const_external_tensor, event, padding_cache __TTL_TRACE_LINE);
+        return;
+    }
+
+    const TTL_shape_t import_shape = TTL_import_pre_fill_cached(
+        internal_sub_tensor, const_external_tensor, &dst_address, &src_address, padding_cache);
+
+    const TTL_int_tensor_t import_int_tensor = TTL_create_int_tensor(
+        dst_address, import_shape, internal_sub_tensor.tensor.layout, internal_sub_tensor.tensor.elem_size);
+
+    const TTL_const_ext_tensor_t import_ext_tensor = TTL_create_const_ext_tensor(
+        src_address, import_shape, const_external_tensor.layout, TTL_create_offset(), const_external_tensor.elem_size);
+
+    TTL_import_convert_base(import_int_tensor, import_ext_tensor, conversion, event __TTL_TRACE_LINE);
+    __TTL_import_boundary(internal_sub_tensor, const_external_tensor, conversion, event __TTL_TRACE_LINE);
+}
+
+/**
+ * @brief Begin the export of the part of an internal sub tensor inside of its origin tensor converting each element
+ *
+ * As TTL_export_sub_tensor the parts of the sub tensor outside of the external tensor are not exported.
+ *
+ * @param internal_sub_tensor A TTL_const_int_sub_tensor_t describing the internal tensor.
+ * @param external_tensor A TTL_ext_tensor_t describing the external tensor.
+ * @param conversion The conversion applied to each element, @see TTL_export_convert_base
+ * @param event A pointer to the event which describes the transfer.
+ */
+static inline void __TTL_TRACE_FN(TTL_export_convert_sub_tensor_base,
+                                  const TTL_const_int_sub_tensor_t internal_sub_tensor,
+                                  const TTL_ext_tensor_t external_tensor, const TTL_conversion_t conversion,
+                                  TTL_event_t *const event) {
+    TTL_local(const void *) src_address;
+    TTL_global(void *) dst_address;
+
+    if (TTL_conversion_empty(conversion)) {
+        TTL_export_sub_tensor(internal_sub_tensor, external_tensor, event __TTL_TRACE_LINE);
+        return;
+    }
+
+    const TTL_shape_t export_shape = TTL_export_clip(internal_sub_tensor, external_tensor, &src_address, &dst_address);
+
+    if (TTL_shape_empty(export_shape)) return;
+
+    const TTL_const_int_tensor_t export_int_tensor = TTL_create_const_int_tensor(
+        src_address, export_shape, internal_sub_tensor.tensor.layout, internal_sub_tensor.tensor.elem_size);
+
+    const TTL_ext_tensor_t export_ext_tensor = TTL_create_ext_tensor(
+        dst_address, export_shape, external_tensor.layout, TTL_create_offset(), external_tensor.elem_size);
+
+    TTL_export_convert_base(export_int_tensor, export_ext_tensor, conversion, event __TTL_TRACE_LINE);
+}
+
+/**
+ * @def __TTL_create_converting_import_export
+ *
+ * @brief Create TTL_import_convert and TTL_export_convert for an internal and an external element type.
+ *
+ * The conversion passed is given the element types of the tensors before it is applied.
+ */
+#define __TTL_create_converting_import_export(ext_type, ext_element_type, int_type, int_element_type)               \
+    /**                                                                                                           \
+     * @brief Begin the import of an external tensor to an internal tensor converting each element               \
+     *                                                                                                            \
+     * @see TTL_import_convert_base for full API and parameter information                                       \
+     */                                                                                                           \
+    static inline void __attribute__((overloadable))                                                              \
+        __TTL_TRACE_FN(TTL_import_convert,                                                                        \
+                       const __TTL_tensor_name(TTL_, , int_, int_type, , _t) internal_tensor,                     \
+                       const __TTL_tensor_name(TTL_, const_, ext_, ext_type, , _t) external_tensor,               \
+                       TTL_conversion_t conversion, TTL_event_t *const event) {                                   \
+        conversion.src_type = ext_element_type;                                                                   \
+        conversion.dst_type = int_element_type;                                                                   \
+        TTL_import_convert_base(*TTL_to_void_tensor(&internal_tensor),                                            \
+                                *TTL_to_void_tensor(&external_tensor),                                            \
+                                conversion,                                                                       \
+                                event __TTL_TRACE_LINE);                                                          \
+    }                                                                                                             \
+                                                                                                                  \
+    /**                                                                                                           \
+     * @brief Begin the import of an external tensor to an internal tensor converting each element               \
+     *                                                                                                            \
+     * @see TTL_import_convert_base for full API and parameter information                                       \
+     */                                                                                                           \
+    static inline void __attribute__((overloadable))                                                              \
+        __TTL_TRACE_FN(TTL_import_convert,                                                                        \
+                       const __TTL_tensor_name(TTL_, , int_, int_type, , _t) internal_tensor,                     \
+                       const __TTL_tensor_name(TTL_, , ext_, ext_type, , _t) external_tensor,                     \
+                       TTL_conversion_t conversion, TTL_event_t *const event) {                                   \
+        conversion.src_type = ext_element_type;                                                                   \
+        conversion.dst_type = int_element_type;                                                                   \
+        TTL_import_convert_base(*TTL_to_void_tensor(&internal_tensor),                                            \
+                                *TTL_to_void_tensor(TTL_to_const_tensor(&external_tensor)),                       \
+                                conversion,                                                                       \
+                                event __TTL_TRACE_LINE);                                                          \
+    }                                                                                                             \
+                                                                                                                  \
+    /**                                                                                                           \
+     * @brief Begin the export of an internal tensor to an external tensor converting each element               \
+     *                                                                                                            \
+     * @see TTL_export_convert_base for full API and parameter information                                       \
+     */                                                                                                           \
+    static inline void __attribute__((overloadable))                                                              \
+        __TTL_TRACE_FN(TTL_export_convert,                                                                        \
+                       const __TTL_tensor_name(TTL_, const_, int_, int_type, , _t) internal_tensor,               \
+                       const __TTL_tensor_name(TTL_, , ext_, ext_type, , _t) external_tensor,                     \
+                       TTL_conversion_t conversion, TTL_event_t *const event) {                                   \
+        conversion.src_type = int_element_type;                                                                   \
+        conversion.dst_type = ext_element_type;                                                                   \
+        TTL_export_convert_base(*TTL_to_void_tensor(&internal_tensor),                                            \
+                                *TTL_to_void_tensor(&external_tensor),                                            \
+                                conversion,                                                                       \
+                                event __TTL_TRACE_LINE);                                                          \
+    }                                                                                                             \
+                                                                                                                  \
+    /**                                                                                                           \
+     * @brief Begin the export of an internal tensor to an external tensor converting each element               \
+     *                                                                                                            \
+     * @see TTL_export_convert_base for full API and parameter information                                       \
+     */                                                                                                           \
+    static inline void __attribute__((overloadable))                                                              \
+        __TTL_TRACE_FN(TTL_export_convert,                                                                        \
+                       const __TTL_tensor_name(TTL_, , int_, int_type, , _t) internal_tensor,                     \
+                       const __TTL_tensor_name(TTL_, , ext_, ext_type, , _t) external_tensor,                     \
+                       TTL_conversion_t conversion, TTL_event_t *const event) {                                   \
+        conversion.src_type = int_element_type;                                                                   \
+        conversion.dst_type = ext_element_type;                                                                   \
+        TTL_export_convert_base(*TTL_to_void_tensor(TTL_to_const_tensor(&internal_tensor)),                       \
+                                *TTL_to_void_tensor(&external_tensor),                                            \
+                                conversion,                                                                       \
+                                event __TTL_TRACE_LINE);                                                          \
+    }
+
+// __TTL_for_each_element_type cannot be nested, so the internal types are listed here.
+__TTL_for_each_element_type(__TTL_create_converting_import_export, char, TTL_ELEMENT_CHAR)
+__TTL_for_each_element_type(__TTL_create_converting_import_export, uchar, TTL_ELEMENT_UCHAR)
+__TTL_for_each_element_type(__TTL_create_converting_import_export, short, TTL_ELEMENT_SHORT)
+__TTL_for_each_element_type(__TTL_create_converting_import_export, ushort, TTL_ELEMENT_USHORT)
+__TTL_for_each_element_type(__TTL_create_converting_import_export, int, TTL_ELEMENT_INT)
+__TTL_for_each_element_type(__TTL_create_converting_import_export, uint, TTL_ELEMENT_UINT)
+__TTL_for_each_element_type(__TTL_create_converting_import_export, long, TTL_ELEMENT_LONG)
+__TTL_for_each_element_type(__TTL_create_converting_import_export, ulong, TTL_ELEMENT_ULONG)
@@ -87,9 +87,13 @@ __TTL_TRACE_FN(TTL_blocking_import, const __TTL_tensor_name(TTL_, , int_, TTL_TE
 /**
  * @brief Implementation of TTL_import_sub_tensor
  *
+ * The parts of the sub tensor outside of the external tensor are filled as the boundary of its
+ * origin describes, @see TTL_boundary_t
+ *
  * @param internal_sub_tensor A TTL_int_tensor_t describing the internal tensor.
  * @param const_external_tensor A TTL_const_ext_tensor_t describing the external tensor.
  * @param event A TTL_event_t type to allow detection of import completion.
+ * @param padding_cache The padding last written to the internal buffer, @see TTL_import_pre_fill_cached
  *
  * @see TTL_import for full API and parameter information
  */
@@ -97,14 +101,20 @@ static inline void __attribute__((overloadable))
 __TTL_TRACE_FN(TTL_import_sub_tensor,
                const __TTL_tensor_name(TTL_, , int_, TTL_TENSOR_TYPE, sub_, _t) internal_sub_tensor,
                const __TTL_tensor_name(TTL_, const_, ext_, TTL_TENSOR_TYPE, , _t) const_external_tensor,
-               TTL_event_t *event) {
+               TTL_event_t *event, TTL_padding_cache_t *const padding_cache) {
     TTL_local(void *) dst_address;
     TTL_global(void *) src_address;
 
-    const TTL_shape_t import_shape = TTL_import_pre_fill(*TTL_to_void_sub_tensor(&internal_sub_tensor),
-                                                         *TTL_to_void_tensor(&const_external_tensor),
-                                                         &dst_address,
-                                                         &src_address);
+    if (TTL_import_zero_copy(*TTL_to_void_sub_tensor(&internal_sub_tensor),
+                             *TTL_to_void_tensor(&const_external_tensor))) {
+        return;
+    }
+
+    const TTL_shape_t import_shape = TTL_import_pre_fill_cached(*TTL_to_void_sub_tensor(&internal_sub_tensor),
+                                                                *TTL_to_void_tensor(&const_external_tensor),
+                                                                &dst_address,
+                                                                &src_address,
+                                                                padding_cache);
 
     const TTL_int_tensor_t import_int_tensor = TTL_create_int_tensor(
         dst_address, import_shape, internal_sub_tensor.tensor.layout, internal_sub_tensor.tensor.elem_size);
@@ -113,6 +123,54 @@ __TTL_TRACE_FN(TTL_import_sub_tensor,
         src_address, import_shape, const_external_tensor.layout, TTL_create_offset(), const_external_tensor.elem_size);
 
     TTL_import(import_int_tensor, import_ext_tensor, event __TTL_TRACE_LINE);
+    __TTL_import_boundary(*TTL_to_void_sub_tensor(&internal_sub_tensor),
+                          *TTL_to_void_tensor(&const_external_tensor),
+                          TTL_create_empty_conversion(),
+                          event __TTL_TRACE_LINE);
+}
+
+/**
+ * @brief Implementation of TTL_import_sub_tensor
+ *
+ * @param internal_sub_tensor A TTL_int_tensor_t describing the internal tensor.
+ * @param const_external_tensor A TTL_const_ext_tensor_t describing the external tensor.
+ * @param event A TTL_event_t type to allow detection of import completion.
+ *
+ * @see TTL_import for full API and parameter information
+ */
+static inline void __attribute__((overloadable))
+__TTL_TRACE_FN(TTL_import_sub_tensor,
+               const __TTL_tensor_name(TTL_, , int_, TTL_TENSOR_TYPE, sub_, _t) internal_sub_tensor,
+               const __TTL_tensor_name(TTL_, const_, ext_, TTL_TENSOR_TYPE, , _t) const_external_tensor,
+               TTL_event_t *event) {
+    TTL_import_sub_tensor(internal_sub_tensor, const_external_tensor, event, NULL __TTL_TRACE_LINE);
+}
+
+/**
+ * @brief Return the sub tensor that holds the result of TTL_import_sub_tensor
+ *
+ * @param internal_sub_tensor The internal sub tensor passed to TTL_import_sub_tensor.
+ * @param const_external_tensor The external tensor passed to TTL_import_sub_tensor.
+ *
+ * This is internal_sub_tensor, unless the import was zero copy in which case the tile is
+ * described in place in the external tensor. @see TTL_ZERO_COPY_IMPORT
+ */
+static inline __TTL_tensor_name(TTL_, , int_, TTL_TENSOR_TYPE, sub_, _t) __attribute__((overloadable))
+    TTL_imported_sub_tensor(const __TTL_tensor_name(TTL_, , int_, TTL_TENSOR_TYPE, sub_, _t) internal_sub_tensor,
+                            const __TTL_tensor_name(TTL_, const_, ext_, TTL_TENSOR_TYPE, , _t) const_external_tensor) {
+    __TTL_tensor_name(TTL_, , int_, TTL_TENSOR_TYPE, sub_, _t) result = internal_sub_tensor;
+
+#ifdef __TTL_ZERO_COPY_IMPORT_ENABLED
+    if (TTL_import_zero_copy(*TTL_to_void_sub_tensor(&internal_sub_tensor),
+                             *TTL_to_void_tensor(&const_external_tensor))) {
+        result.tensor.base = (TTL_local(TTL_TENSOR_TYPE *))const_external_tensor.base;
+        result.tensor.layout = const_external_tensor.layout;
+    }
+#else
+    (void)const_external_tensor;
+#endif
+
+    return result;
 }
 
 /**
@@ -176,4 +234,368 @@ __TTL_TRACE_FN(TTL_blocking_export, const __TTL_tensor_name(TTL_, , int_, TTL_TE
                const __TTL_tensor_name(TTL_, , ext_, TTL_TENSOR_TYPE, , _t) external_tensor) {
     TTL_blocking_export_base(*TTL_to_void_tensor(TTL_to_const_tensor(&internal_tensor)),
                              *TTL_to_void_tensor(&external_tensor) __TTL_TRACE_LINE);
-}
\ No newline at end of file
+}
+
+/**
+ * @brief Begin the export of the part of an internal sub tensor inside of its origin tensor
+ *
+ * The counterpart of TTL_import_sub_tensor, the parts of the sub tensor whose origin.sub_offset
+ * places them outside of origin.shape, for example the augmentation of a tile at the edge of the
+ * tensor, are not exported. A sub tensor inside its origin tensor is exported whole.
+ *
+ * @param internal_sub_tensor A TTL_const_int_sub_tensor_t describing the internal tensor.
+ * @param external_tensor A TTL_ext_tensor_t describing the external tensor, whose base is the
+ * element at the sub tensor's offset.
+ * @param event A TTL_event_t type to allow detection of export completion.
+ *
+ * @see TTL_export for full API and parameter information
+ */
+static inline void __attribute__((overloadable))
+__TTL_TRACE_FN(TTL_export_sub_tensor,
+               const __TTL_tensor_name(TTL_, const_, int_, TTL_TENSOR_TYPE, sub_, _t) internal_sub_tensor,
+               const __TTL_tensor_name(TTL_, , ext_, TTL_TENSOR_TYPE, , _t) external_tensor, TTL_event_t *event) {
+    TTL_local(const void *) src_address;
+    TTL_global(void *) dst_address;
+
+    const TTL_shape_t export_shape = TTL_export_clip(*TTL_to_void_sub_tensor(&internal_sub_tensor),
+                                                     *TTL_to_void_tensor(&external_tensor),
+                                                     &src_address,
+                                                     &dst_address);
+
+    if (TTL_shape_empty(export_shape)) return;
+
+    const TTL_const_int_tensor_t export_int_tensor = TTL_create_const_int_tensor(
+        src_address, export_shape, internal_sub_tensor.tensor.layout, internal_sub_tensor.tensor.elem_size);
+
+    const TTL_ext_tensor_t export_ext_tensor = TTL_create_ext_tensor(
+        dst_address, export_shape, external_tensor.layout, TTL_create_offset(), external_tensor.elem_size);
+
+    TTL_export(export_int_tensor, export_ext_tensor, event __TTL_TRACE_LINE);
+}
+
+/**
+ * @brief Begin the export of the part of an internal sub tensor inside of its origin tensor
+ *
+ * @param internal_sub_tensor A TTL_int_sub_tensor_t describing the internal tensor.
+ * @param external_tensor A TTL_ext_tensor_t describing the external tensor.
+ * @param event A TTL_event_t type to allow detection of export completion.
+ *
+ * @see TTL_export_sub_tensor for full API and parameter information
+ */
+static inline void __attribute__((overloadable))
+__TTL_TRACE_FN(TTL_export_sub_tensor,
+               const __TTL_tensor_name(TTL_, , int_, TTL_TENSOR_TYPE, sub_, _t) internal_sub_tensor,
+               const __TTL_tensor_name(TTL_, , ext_, TTL_TENSOR_TYPE, , _t) external_tensor, TTL_event_t *event) {
+    TTL_export_sub_tensor(*TTL_to_const_sub_tensor(&internal_sub_tensor), external_tensor, event __TTL_TRACE_LINE);
+}
+
+/**
+ * @brief Import a tile of a compressed external tensor to an internal tensor
+ *
+ * @param internal_tensor A TTL_int_tensor_t describing the internal tensor.
+ * @param external_tensor The compressed tensor imported from.
+ * @param offset The offset in the external tensor of the tile.
+ * @param event A pointer to the event which describes the transfer.
+ *
+ * @see TTL_import_compressed_base for full API and parameter information
+ */
+static inline void __attribute__((overloadable))
+__TTL_TRACE_FN(TTL_import_compressed, const __TTL_tensor_name(TTL_, , int_, TTL_TENSOR_TYPE, , _t) internal_tensor,
+               const TTL_compressed_ext_tensor_t external_tensor, const TTL_offset_t offset,
+               TTL_event_t *const event) {
+    TTL_import_compressed_base(*TTL_to_void_tensor(&internal_tensor), external_tensor, offset, event __TTL_TRACE_LINE);
+}
+
+/**
+ * @brief Export an internal tensor to a tile of a compressed external tensor
+ *
+ * @param internal_tensor A TTL_const_int_tensor_t describing the internal tensor.
+ * @param external_tensor The compressed tensor exported to.
+ * @param offset The offset in the external tensor of the tile.
+ * @param event A pointer to the event which describes the transfer.
+ *
+ * @see TTL_export_compressed_base for full API and parameter information
+ */
+static inline void __attribute__((overloadable))
+__TTL_TRACE_FN(TTL_export_compressed,
+               const __TTL_tensor_name(TTL_, const_, int_, TTL_TENSOR_TYPE, , _t) internal_tensor,
+               const TTL_compressed_ext_tensor_t external_tensor, const TTL_offset_t offset,
+               TTL_event_t *const event) {
+    TTL_export_compressed_base(*TTL_to_void_tensor(&internal_tensor), external_tensor, offset, event __TTL_TRACE_LINE);
+}
+
+/**
+ * @brief Export an internal tensor to a tile of a compressed external tensor
+ *
+ * @param internal_tensor A TTL_int_tensor_t describing the internal tensor.
+ * @param external_tensor The compressed tensor exported to.
+ * @param offset The offset in the external tensor of the tile.
+ * @param event A pointer to the event which describes the transfer.
+ *
+ * @see TTL_export_compressed_base for full API and parameter information
+ */
+static inline void __attribute__((overloadable))
+__TTL_TRACE_FN(TTL_export_compressed, const __TTL_tensor_name(TTL_, , int_, TTL_TENSOR_TYPE, , _t) internal_tensor,
+               const TTL_compressed_ext_tensor_t external_tensor, const TTL_offset_t offset,
+               TTL_event_t *const event) {
+    TTL_export_compressed_base(
+        *TTL_to_void_tensor(TTL_to_const_tensor(&internal_tensor)), external_tensor, offset, event __TTL_TRACE_LINE);
+}
+
+/**
+ * @brief Compress an external tensor, writing the blocks one after another
+ *
+ * @param compressed The compressed tensor written.
+ * @param tensor A TTL_const_ext_tensor_t describing the tensor compressed.
+ *
+ * @see TTL_compress_tensor_base for full API and parameter information
+ */
+static inline size_t __attribute__((overloadable))
+TTL_compress_tensor(const TTL_compressed_ext_tensor_t compressed,
+                    const __TTL_tensor_name(TTL_, const_, ext_, TTL_TENSOR_TYPE, , _t) tensor) {
+    return TTL_compress_tensor_base(compressed, *TTL_to_void_tensor(&tensor));
+}
+
+/**
+ * @brief Compress an external tensor, writing the blocks one after another
+ *
+ * @param compressed The compressed tensor written.
+ * @param tensor A TTL_ext_tensor_t describing the tensor compressed.
+ *
+ * @see TTL_compress_tensor_base for full API and parameter information
+ */
+static inline size_t __attribute__((overloadable))
+TTL_compress_tensor(const TTL_compressed_ext_tensor_t compressed,
+                    const __TTL_tensor_name(TTL_, , ext_, TTL_TENSOR_TYPE, , _t) tensor) {
+    return TTL_compress_tensor_base(compressed, *TTL_to_void_tensor(TTL_to_const_tensor(&tensor)));
+}
+
+/**
+ * @brief Add the import of the external tensor to the internal tensor to a batch
+ *
+ * @param batch The batch to add the import to.
+ * @param internal_tensor A TTL_int_tensor_t describing the internal tensor.
+ * @param external_tensor A TTL_const_ext_tensor_t describing the external tensor.
+ *
+ * @return false, leaving the batch unchanged, if the batch is full.
+ *
+ * @see TTL_copy_batch_t
+ */
+static inline bool __attribute__((overloadable))
+TTL_batch_import(TTL_copy_batch_t *const batch,
+                 const __TTL_tensor_name(TTL_, , int_, TTL_TENSOR_TYPE, , _t) internal_tensor,
+                 const __TTL_tensor_name(TTL_, const_, ext_, TTL_TENSOR_TYPE, , _t) external_tensor) {
+    return TTL_batch_import_base(batch, *TTL_to_void_tensor(&internal_tensor), *TTL_to_void_tensor(&external_tensor));
+}
+
+/**
+ * @brief Add the import of the external tensor to the internal tensor to a batch
+ *
+ * @param batch The batch to add the import to.
+ * @param internal_tensor A TTL_int_tensor_t describing the internal tensor.
+ * @param external_tensor A TTL_ext_tensor_t describing the external tensor.
+ *
+ * @return false, leaving the batch unchanged, if the batch is full.
+ */
+static inline bool __attribute__((overloadable))
+TTL_batch_import(TTL_copy_batch_t *const batch,
+                 const __TTL_tensor_name(TTL_, , int_, TTL_TENSOR_TYPE, , _t) internal_tensor,
+                 const __TTL_tensor_name(TTL_, , ext_, TTL_TENSOR_TYPE, , _t) external_tensor) {
+    return TTL_batch_import_base(
+        batch, *TTL_to_void_tensor(&internal_tensor), *TTL_to_void_tensor(TTL_to_const_tensor(&external_tensor)));
+}
+
+/**
+ * @brief Add the export of the internal tensor to the external tensor to a batch
+ *
+ * @param batch The batch to add the export to.
+ * @param internal_tensor A TTL_const_int_tensor_t describing the internal tensor.
+ * @param external_tensor A TTL_ext_tensor_t describing the external tensor.
+ *
+ * @return false, leaving the batch unchanged, if the batch is full.
+ *
+ * @see TTL_copy_batch_t
+ */
+static inline bool __attribute__((overloadable))
+TTL_batch_export(TTL_copy_batch_t *const batch,
+                 const __TTL_tensor_name(TTL_, const_, int_, TTL_TENSOR_TYPE, , _t) internal_tensor,
+                 const __TTL_tensor_name(TTL_, , ext_, TTL_TENSOR_TYPE, , _t) external_tensor) {
+    return TTL_batch_export_base(batch, *TTL_to_void_tensor(&internal_tensor), *TTL_to_void_tensor(&external_tensor));
+}
+
+/**
+ * @brief Add the export of the internal tensor to the external tensor to a batch
+ *
+ * @param batch The batch to add the export to.
+ * @param internal_tensor A TTL_int_tensor_t describing the internal tensor.
+ * @param external_tensor A TTL_ext_tensor_t describing the external tensor.
+ *
+ * @return false, leaving the batch unchanged, if the batch is full.
+ */
+static inline bool __attribute__((overloadable))
+TTL_batch_export(TTL_copy_batch_t *const batch,
+                 const __TTL_tensor_name(TTL_, , int_, TTL_TENSOR_TYPE, , _t) internal_tensor,
+                 const __TTL_tensor_name(TTL_, , ext_, TTL_TENSOR_TYPE, , _t) external_tensor) {
+    return TTL_batch_export_base(
+        batch, *TTL_to_void_tensor(TTL_to_const_tensor(&internal_tensor)), *TTL_to_void_tensor(&external_tensor));
+}
+
+/**
+ * @brief Begin the import of the external rows named by an index tensor to the rows of an internal tensor
+ *
+ * @param internal_tensor A TTL_int_tensor_t describing the internal tensor.
+ * @param external_tensor A TTL_const_ext_tensor_t describing the external tensor.
+ * @param indices A TTL_const_int_int_tensor_t holding the external row for each internal row.
+ * @param event A pointer to the event which describes the transfers.
+ *
+ * @see TTL_import_gather_base for full API and parameter information
+ */
+static inline void __attribute__((overloadable))
+__TTL_TRACE_FN(TTL_import_gather, const __TTL_tensor_name(TTL_, , int_, TTL_TENSOR_TYPE, , _t) internal_tensor,
+               const __TTL_tensor_name(TTL_, const_, ext_, TTL_TENSOR_TYPE, , _t) external_tensor,
+               const TTL_const_int_int_tensor_t indices, TTL_event_t *const event) {
+    TTL_import_gather_base(*TTL_to_void_tensor(&internal_tensor),
+                           *TTL_to_void_tensor(&external_tensor),
+                           indices,
+                           event __TTL_TRACE_LINE);
+}
+
+/**
+ * @brief Begin the import of the external rows named by an index tensor to the rows of an internal tensor
+ *
+ * @param internal_tensor A TTL_int_tensor_t describing the internal tensor.
+ * @param external_tensor A TTL_ext_tensor_t describing the external tensor.
+ * @param indices A TTL_const_int_int_tensor_t holding the external row for each internal row.
+ * @param event A pointer to the event which describes the transfers.
+ *
+ * @see TTL_import_gather_base for full API and parameter information
+ */
+static inline void __attribute__((overloadable))
+__TTL_TRACE_FN(TTL_import_gather, const __TTL_tensor_name(TTL_, , int_, TTL_TENSOR_TYPE, , _t) internal_tensor,
+               const __TTL_tensor_name(TTL_, , ext_, TTL_TENSOR_TYPE, , _t) external_tensor,
+               const TTL_const_int_int_tensor_t indices, TTL_event_t *const event) {
+    TTL_import_gather_base(*TTL_to_void_tensor(&internal_tensor),
+                           *TTL_to_void_tensor(TTL_to_const_tensor(&external_tensor)),
+                           indices,
+                           event __TTL_TRACE_LINE);
+}
+
+/**
+ * @brief Begin the export of the rows of an internal tensor to the external rows named by an index tensor
+ *
+ * @param internal_tensor A TTL_const_int_tensor_t describing the internal tensor.
+ * @param external_tensor A TTL_ext_tensor_t describing the external tensor.
+ * @param indices A TTL_const_int_int_tensor_t holding the external row for each internal row.
+ * @param event A pointer to the event which describes the transfers.
+ *
+ * @see TTL_export_scatter_base for full API and parameter information
+ */
+static inline void __attribute__((overloadable))
+__TTL_TRACE_FN(TTL_export_scatter, const __TTL_tensor_name(TTL_, const_, int_, TTL_TENSOR_TYPE, , _t) internal_tensor,
+               const __TTL_tensor_name(TTL_, , ext_, TTL_TENSOR_TYPE, , _t) external_tensor,
+               const TTL_const_int_int_tensor_t indices, TTL_event_t *const event) {
+    TTL_export_scatter_base(*TTL_to_void_tensor(&internal_tensor),
+                            *TTL_to_void_tensor(&external_tensor),
+                            indices,
+                            event __TTL_TRACE_LINE);
+}
+
+/**
+ * @brief Begin the export of the rows of an internal tensor to the external rows named by an index tensor
+ *
+ * @param internal_tensor A TTL_int_tensor_t describing the internal tensor.
+ * @param external_tensor A TTL_ext_tensor_t describing the external tensor.
+ * @param indices A TTL_const_int_int_tensor_t holding the external row for each internal row.
+ * @param event A pointer to the event which describes the transfers.
+ *
+ * @see TTL_export_scatter_base for full API and parameter information
+ */
+static inline void __attribute__((overloadable))
+__TTL_TRACE_FN(TTL_export_scatter, const __TTL_tensor_name(TTL_, , int_, TTL_TENSOR_TYPE, , _t) internal_tensor,
+               const __TTL_tensor_name(TTL_, , ext_, TTL_TENSOR_TYPE, , _t) external_tensor,
+               const TTL_const_int_int_tensor_t indices, TTL_event_t *const event) {
+    TTL_export_scatter_base(*TTL_to_void_tensor(TTL_to_const_tensor(&internal_tensor)),
+                            *TTL_to_void_tensor(&external_tensor),
+                            indices,
+                            event __TTL_TRACE_LINE);
+}
+
+/**
+ * @brief Begin the import of an external tensor to an internal tensor with an axis permutation
+ *
+ * @param internal_tensor A TTL_int_tensor_t describing the internal tensor.
+ * @param external_tensor A TTL_const_ext_tensor_t describing the external tensor.
+ * @param permutation The external axis that each internal axis runs along.
+ * @param event A pointer to the event which describes the transfer.
+ *
+ * @see TTL_import_permuted_base for full API and parameter information
+ */
+static inline void __attribute__((overloadable))
+__TTL_TRACE_FN(TTL_import_permuted, const __TTL_tensor_name(TTL_, , int_, TTL_TENSOR_TYPE, , _t) internal_tensor,
+               const __TTL_tensor_name(TTL_, const_, ext_, TTL_TENSOR_TYPE, , _t) external_tensor,
+               const TTL_permutation_t permutation, TTL_event_t *const event) {
+    TTL_import_permuted_base(*TTL_to_void_tensor(&internal_tensor),
+                             *TTL_to_void_tensor(&external_tensor),
+                             permutation,
+                             event __TTL_TRACE_LINE);
+}
+
+/**
+ * @brief Begin the import of an external tensor to an internal tensor with an axis permutation
+ *
+ * @param internal_tensor A TTL_int_tensor_t describing the internal tensor.
+ * @param external_tensor A TTL_ext_tensor_t describing the external tensor.
+ * @param permutation The external axis that each internal axis runs along.
+ * @param event A pointer to the event which describes the transfer.
+ *
+ * @see TTL_import_permuted_base for full API and parameter information
+ */
+static inline void __attribute__((overloadable))
+__TTL_TRACE_FN(TTL_import_permuted, const __TTL_tensor_name(TTL_, , int_, TTL_TENSOR_TYPE, , _t) internal_tensor,
+               const __TTL_tensor_name(TTL_, , ext_, TTL_TENSOR_TYPE, , _t) external_tensor,
+               const TTL_permutation_t permutation, TTL_event_t *const event) {
+    TTL_import_permuted_base(*TTL_to_void_tensor(&internal_tensor),
+                             *TTL_to_void_tensor(TTL_to_const_tensor(&external_tensor)),
+                             permutation,
+                             event __TTL_TRACE_LINE);
+}
+
+/**
+ * @brief Begin the export of an internal tensor to an external tensor with an axis permutation
+ *
+ * @param internal_tensor A TTL_const_int_tensor_t describing the internal tensor.
+ * @param external_tensor A TTL_ext_tensor_t describing the external tensor.
+ * @param permutation The external axis that each internal axis runs along.
+ * @param event A pointer to the event which describes the transfer.
+ *
+ * @see TTL_export_permuted_base for full API and parameter information
+ */
+static inline void __attribute__((overloadable))
+__TTL_TRACE_FN(TTL_export_permuted, const __TTL_tensor_name(TTL_, const_, int_, TTL_TENSOR_TYPE, , _t) internal_tensor,
+               const __TTL_tensor_name(TTL_, , ext_, TTL_TENSOR_TYPE, , _t) external_tensor,
+               const TTL_permutation_t permutation, TTL_event_t *const event) {
+    TTL_export_permuted_base(*TTL_to_void_tensor(&internal_tensor),
+                             *TTL_to_void_tensor(&external_tensor),
+                             permutation,
+                             event __TTL_TRACE_LINE);
+}
+
+/**
+ * @brief Begin the export of an internal tensor to an external tensor with an axis permutation
+ *
+ * @param internal_tensor A TTL_int_tensor_t describing the internal tensor.
+ * @param external_tensor A TTL_ext_tensor_t describing the external tensor.
+ * @param permutation The external axis that each internal axis runs along.
+ * @param event A pointer to the event which describes the transfer.
+ *
+ * @see TTL_export_permuted_base for full API and parameter information
+ */
+static inline void __attribute__((overloadable))
+__TTL_TRACE_FN(TTL_export_permuted, const __TTL_tensor_name(TTL_, , int_, TTL_TENSOR_TYPE, , _t) internal_tensor,
+               const __TTL_tensor_name(TTL_, , ext_, TTL_TENSOR_TYPE, , _t) external_tensor,
+               const TTL_permutation_t permutation, TTL_event_t *const event) {
+    TTL_export_permuted_base(*TTL_to_void_tensor(TTL_to_const_tensor(&internal_tensor)),
+                             *TTL_to_void_tensor(&external_tensor),
+                             permutation,
+                             event __TTL_TRACE_LINE);
+}
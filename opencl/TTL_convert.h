@@ -0,0 +1,178 @@
+/*
+ * TTL_convert.h
+ *
+ * Copyright (c) 2023 Mobileye
+ *
+ * Licensed under the Apache License, Version 2.0 (the License);
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+/*
+ * Conversion of elements between types as they are transferred, @see TTL_conversion_t
+ *
+ * Elements are converted a chunk at a time, each chunk is loaded as long, scaled if the
+ * conversion is affine, then saturated to the destination type as it is stored. Each step
+ * is a simple loop for a single type, so compilers are able to vectorize them.
+ *
+ * This file presumes that TTL_types.h and the target's types have been included.
+ */
+
+/**
+ * @def __TTL_CONVERT_CHUNK
+ *
+ * @brief The number of elements converted at a time, held in private memory as long.
+ */
+#define __TTL_CONVERT_CHUNK 64
+
+/**
+ * @def __TTL_create_convert_load
+ *
+ * @brief Create __TTL_convert_load_<location>, which loads count elements from location memory.
+ */
+#define __TTL_create_convert_load(location)                                                                      \
+    static inline void __TTL_convert_load_##location(                                                            \
+        long *const values, TTL_##location(const void *) const src, const size_t count, TTL_element_type_t type) { \
+        switch (type) {                                                                                          \
+            case TTL_ELEMENT_CHAR:                                                                               \
+                for (size_t i = 0; i < count; i++) values[i] = ((TTL_##location(const char *))src)[i];          \
+                break;                                                                                           \
+            case TTL_ELEMENT_UCHAR:                                                                              \
+                for (size_t i = 0; i < count; i++) values[i] = ((TTL_##location(const uchar *))src)[i];         \
+                break;                                                                                           \
+            case TTL_ELEMENT_SHORT:                                                                              \
+                for (size_t i = 0; i < count; i++) values[i] = ((TTL_##location(const short *))src)[i];         \
+                break;                                                                                           \
+            case TTL_ELEMENT_USHORT:                                                                             \
+                for (size_t i = 0; i < count; i++) values[i] = ((TTL_##location(const ushort *))src)[i];        \
+                break;                                                                                           \
+            case TTL_ELEMENT_INT:                                                                                \
+                for (size_t i = 0; i < count; i++) values[i] = ((TTL_##location(const int *))src)[i];           \
+                break;                                                                                           \
+            case TTL_ELEMENT_UINT:                                                                               \
+                for (size_t i = 0; i < count; i++) values[i] = ((TTL_##location(const uint *))src)[i];          \
+                break;                                                                                           \
+            case TTL_ELEMENT_LONG:                                                                               \
+                for (size_t i = 0; i < count; i++) values[i] = ((TTL_##location(const long *))src)[i];          \
+                break;                                                                                           \
+            case TTL_ELEMENT_ULONG:                                                                              \
+                for (size_t i = 0; i < count; i++) {                                                             \
+                    const ulong value = ((TTL_##location(const ulong *))src)[i];                                 \
+                    values[i] = value > (ulong)LONG_MAX ? LONG_MAX : (long)value;                                \
+                }                                                                                                \
+                break;                                                                                           \
+        }                                                                                                        \
+    }
+
+/**
+ * @def __TTL_CONVERT_STORE
+ *
+ * @brief Store count values to dst as type, saturated to [min, max]
+ */
+#define __TTL_CONVERT_STORE(location, type, min, max)                                                            \
+    for (size_t i = 0; i < count; i++) {                                                                         \
+        ((TTL_##location(type *))dst)[i] = (type)(values[i] < (min) ? (min) : values[i] > (max) ? (max) : values[i]); \
+    }                                                                                                            \
+    break
+
+/**
+ * @def __TTL_create_convert_store
+ *
+ * @brief Create __TTL_convert_store_<location>, which stores count elements to location memory.
+ *
+ * ulong values are at most LONG_MAX, as they have passed through a long.
+ */
+#define __TTL_create_convert_store(location)                                                                     \
+    static inline void __TTL_convert_store_##location(                                                           \
+        TTL_##location(void *) const dst, const long *const values, const size_t count, TTL_element_type_t type) { \
+        switch (type) {                                                                                          \
+            case TTL_ELEMENT_CHAR: __TTL_CONVERT_STORE(location, char, CHAR_MIN, CHAR_MAX);                      \
+            case TTL_ELEMENT_UCHAR: __TTL_CONVERT_STORE(location, uchar, 0, UCHAR_MAX);                          \
+            case TTL_ELEMENT_SHORT: __TTL_CONVERT_STORE(location, short, SHRT_MIN, SHRT_MAX);                    \
+            case TTL_ELEMENT_USHORT: __TTL_CONVERT_STORE(location, ushort, 0, USHRT_MAX);                        \
+            case TTL_ELEMENT_INT: __TTL_CONVERT_STORE(location, int, INT_MIN, INT_MAX);                          \
+            case TTL_ELEMENT_UINT: __TTL_CONVERT_STORE(location, uint, 0, (long)UINT_MAX);                       \
+            case TTL_ELEMENT_LONG: __TTL_CONVERT_STORE(location, long, LONG_MIN, LONG_MAX);                      \
+            case TTL_ELEMENT_ULONG: __TTL_CONVERT_STORE(location, ulong, 0, LONG_MAX);                           \
+        }                                                                                                        \
+    }
+
+__TTL_create_convert_load(global);
+__TTL_create_convert_load(local);
+__TTL_create_convert_store(global);
+__TTL_create_convert_store(local);
+
+/**
+ * @brief Apply an affine conversion to count values, rounding half away from zero.
+ */
+static inline void __TTL_convert_affine(long *const values, const size_t count, const TTL_conversion_t conversion) {
+    for (size_t i = 0; i < count; i++) {
+        const float value = (values[i] * conversion.scale) + conversion.offset;
+
+        values[i] = value >= (float)LONG_MAX   ? LONG_MAX
+                    : value <= (float)LONG_MIN ? LONG_MIN
+                                               : (long)(value + (value < 0 ? -0.5f : 0.5f));
+    }
+}
+
+/**
+ * @def __TTL_create_convert_3D
+ *
+ * @brief Create __TTL_convert_<direction>_3D, converting a 3D block from src_location to dst_location memory.
+ *
+ * The spacings are in elements of the side they describe. The lines of the block are divided
+ * between the work-items, each converting its own lines before returning, so the block is only
+ * complete once every work-item has returned.
+ */
+#define __TTL_create_convert_3D(direction, dst_location, src_location)                                           \
+    static inline void __TTL_convert_##direction##_3D(TTL_##dst_location(void *) const dst,                     \
+                                                      TTL_##src_location(const void *) const src,               \
+                                                      const TTL_conversion_t conversion,                        \
+                                                      const size_t num_elements_per_line,                       \
+                                                      const size_t num_lines,                                   \
+                                                      const size_t num_planes,                                  \
+                                                      const size_t src_total_line_length,                       \
+                                                      const size_t src_total_plane_spacing,                     \
+                                                      const size_t dst_total_line_length,                       \
+                                                      const size_t dst_total_plane_spacing) {                   \
+        const size_t src_bytes = TTL_element_size(conversion.src_type);                                         \
+        const size_t dst_bytes = TTL_element_size(conversion.dst_type);                                         \
+        long values[__TTL_CONVERT_CHUNK];                                                                        \
+                                                                                                                 \
+        for (size_t block_line = TTL_WORK_ITEM_ID; block_line < (num_lines * num_planes);                        \
+             block_line += TTL_NUMBER_OF_WORK_ITEMS) {                                                           \
+            const size_t line = block_line % num_lines;                                                          \
+            const size_t plane = block_line / num_lines;                                                         \
+                                                                                                                 \
+            TTL_##src_location(const uchar *) const src_line =                                                   \
+                (TTL_##src_location(const uchar *))src +                                                         \
+                (((plane * src_total_plane_spacing) + (line * src_total_line_length)) * src_bytes);              \
+            TTL_##dst_location(uchar *) const dst_line =                                                         \
+                (TTL_##dst_location(uchar *))dst +                                                               \
+                (((plane * dst_total_plane_spacing) + (line * dst_total_line_length)) * dst_bytes);              \
+                                                                                                                 \
+            for (size_t first = 0; first < num_elements_per_line; first += __TTL_CONVERT_CHUNK) {                \
+                const size_t remaining = num_elements_per_line - first;                                          \
+                const size_t count = remaining < __TTL_CONVERT_CHUNK ? remaining : __TTL_CONVERT_CHUNK;          \
+                                                                                                                 \
+                __TTL_convert_load_##src_location(                                                               \
+                    values, src_line + (first * src_bytes), count, conversion.src_type);                         \
+                if (conversion.kind == TTL_CONVERT_AFFINE) __TTL_convert_affine(values, count, conversion);      \
+                __TTL_convert_store_##dst_location(                                                              \
+                    dst_line + (first * dst_bytes), values, count, conversion.dst_type);                         \
+            }                                                                                                    \
+        }                                                                                                        \
+    }
+
+__TTL_create_convert_3D(import, local, global);
+__TTL_create_convert_3D(export, global, local);
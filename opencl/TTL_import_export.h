@@ -28,6 +28,313 @@
 #include "TTL_async_work_group_copy_3D3D.h"
 #endif
 
+/**
+ * @def TTL_IMPORT_COPY_3D3D
+ *
+ * @brief The copy used to import, a target may define it to treat imports differently to exports.
+ */
+#ifndef TTL_IMPORT_COPY_3D3D
+#define TTL_IMPORT_COPY_3D3D async_work_group_copy_3D3D
+#endif
+
+/**
+ * @def TTL_EXPORT_COPY_3D3D
+ *
+ * @brief The copy used to export, a target may define it to treat exports differently to imports.
+ */
+#ifndef TTL_EXPORT_COPY_3D3D
+#define TTL_EXPORT_COPY_3D3D async_work_group_copy_3D3D
+#endif
+
+#ifndef TTL_IMPORT_PERMUTED_COPY
+/**
+ * @brief Import one line whose elements are element_spacing elements apart in the source.
+ */
+static inline event_t __TTL_async_strided_import_line(__local uchar *const dst, const __global uchar *const src,
+                                                      const size_t num_bytes_per_element,
+                                                      const size_t num_elements, const size_t element_spacing,
+                                                      event_t event) {
+    switch (num_bytes_per_element) {
+        case 1:
+            return async_work_group_strided_copy(dst, src, num_elements, element_spacing, event);
+        case 2:
+            return async_work_group_strided_copy(
+                (__local ushort *)dst, (const __global ushort *)src, num_elements, element_spacing, event);
+        case 4:
+            return async_work_group_strided_copy(
+                (__local uint *)dst, (const __global uint *)src, num_elements, element_spacing, event);
+        case 8:
+            return async_work_group_strided_copy(
+                (__local ulong *)dst, (const __global ulong *)src, num_elements, element_spacing, event);
+        default:
+            for (size_t element = 0; element < num_elements; element++) {
+                event = async_work_group_copy(dst + (element * num_bytes_per_element),
+                                              src + (element * element_spacing * num_bytes_per_element),
+                                              num_bytes_per_element,
+                                              event);
+            }
+            return event;
+    }
+}
+
+/**
+ * @brief Import a 3D block whose lines are not contiguous in the source, using OpenCL's strided copies.
+ */
+static inline event_t __TTL_async_permuted_import_3D(__local void *const dst, const __global void *const src,
+                                                     size_t num_bytes_per_element, size_t num_elements_per_line,
+                                                     size_t num_lines, size_t num_planes, size_t src_element_spacing,
+                                                     size_t src_total_line_length, size_t src_total_plane_spacing,
+                                                     size_t dst_total_line_length, size_t dst_total_plane_spacing,
+                                                     event_t event) {
+    for (size_t plane = 0; plane < num_planes; plane++) {
+        for (size_t line = 0; line < num_lines; line++) {
+            event = __TTL_async_strided_import_line(
+                (__local uchar *)dst +
+                    (((plane * dst_total_plane_spacing) + (line * dst_total_line_length)) * num_bytes_per_element),
+                (const __global uchar *)src +
+                    (((plane * src_total_plane_spacing) + (line * src_total_line_length)) * num_bytes_per_element),
+                num_bytes_per_element,
+                num_elements_per_line,
+                src_element_spacing,
+                event);
+        }
+    }
+
+    return event;
+}
+
+/**
+ * @def TTL_IMPORT_PERMUTED_COPY
+ *
+ * @brief The copy used to import with an axis permutation, a target may define it to use a faster transposition.
+ *
+ * Takes the parameters of async_work_group_copy_3D3D without the offsets, plus the spacing of
+ * the elements of a line in the source.
+ */
+#define TTL_IMPORT_PERMUTED_COPY __TTL_async_permuted_import_3D
+#endif
+
+#ifndef TTL_EXPORT_PERMUTED_COPY
+/**
+ * @brief Export one line whose elements are element_spacing elements apart in the destination.
+ */
+static inline event_t __TTL_async_strided_export_line(__global uchar *const dst, const __local uchar *const src,
+                                                      const size_t num_bytes_per_element,
+                                                      const size_t num_elements, const size_t element_spacing,
+                                                      event_t event) {
+    switch (num_bytes_per_element) {
+        case 1:
+            return async_work_group_strided_copy(dst, src, num_elements, element_spacing, event);
+        case 2:
+            return async_work_group_strided_copy(
+                (__global ushort *)dst, (const __local ushort *)src, num_elements, element_spacing, event);
+        case 4:
+            return async_work_group_strided_copy(
+                (__global uint *)dst, (const __local uint *)src, num_elements, element_spacing, event);
+        case 8:
+            return async_work_group_strided_copy(
+                (__global ulong *)dst, (const __local ulong *)src, num_elements, element_spacing, event);
+        default:
+            for (size_t element = 0; element < num_elements; element++) {
+                event = async_work_group_copy(dst + (element * element_spacing * num_bytes_per_element),
+                                              src + (element * num_bytes_per_element),
+                                              num_bytes_per_element,
+                                              event);
+            }
+            return event;
+    }
+}
+
+/**
+ * @brief Export a 3D block whose lines are not contiguous in the destination, using OpenCL's strided copies.
+ */
+static inline event_t __TTL_async_permuted_export_3D(__global void *const dst, const __local void *const src,
+                                                     size_t num_bytes_per_element, size_t num_elements_per_line,
+                                                     size_t num_lines, size_t num_planes,
+                                                     size_t src_total_line_length, size_t src_total_plane_spacing,
+                                                     size_t dst_element_spacing, size_t dst_total_line_length,
+                                                     size_t dst_total_plane_spacing, event_t event) {
+    for (size_t plane = 0; plane < num_planes; plane++) {
+        for (size_t line = 0; line < num_lines; line++) {
+            event = __TTL_async_strided_export_line(
+                (__global uchar *)dst +
+                    (((plane * dst_total_plane_spacing) + (line * dst_total_line_length)) * num_bytes_per_element),
+                (const __local uchar *)src +
+                    (((plane * src_total_plane_spacing) + (line * src_total_line_length)) * num_bytes_per_element),
+                num_bytes_per_element,
+                num_elements_per_line,
+                dst_element_spacing,
+                event);
+        }
+    }
+
+    return event;
+}
+
+/**
+ * @def TTL_EXPORT_PERMUTED_COPY
+ *
+ * @brief The copy used to export with an axis permutation, a target may define it to use a faster transposition.
+ *
+ * Takes the parameters of async_work_group_copy_3D3D without the offsets, plus the spacing of
+ * the elements of a line in the destination.
+ */
+#define TTL_EXPORT_PERMUTED_COPY __TTL_async_permuted_export_3D
+#endif
+
+#include "TTL_convert.h"
+
+#ifndef TTL_IMPORT_CONVERTED_COPY
+/**
+ * @brief Import a 3D block converting each element, returning when complete.
+ *
+ * The lines of the block are divided between the work-items, so each element is read from
+ * global memory once by the work-group.
+ */
+static inline event_t __TTL_converted_import_3D(__local void *const dst, const __global void *const src,
+                                                const TTL_conversion_t conversion, size_t num_elements_per_line,
+                                                size_t num_lines, size_t num_planes, size_t src_total_line_length,
+                                                size_t src_total_plane_spacing, size_t dst_total_line_length,
+                                                size_t dst_total_plane_spacing, event_t event) {
+    __TTL_convert_import_3D(dst,
+                            src,
+                            conversion,
+                            num_elements_per_line,
+                            num_lines,
+                            num_planes,
+                            src_total_line_length,
+                            src_total_plane_spacing,
+                            dst_total_line_length,
+                            dst_total_plane_spacing);
+
+    // The block is complete, and seen by every work-item, on return.
+    __TTL_local_barrier();
+
+    return event;
+}
+
+/**
+ * @def TTL_IMPORT_CONVERTED_COPY
+ *
+ * @brief The copy used to import with a conversion, a target may define it to convert asynchronously.
+ *
+ * Takes the parameters of async_work_group_copy_3D3D without the offsets, with the conversion in
+ * place of the element size. The line and plane spacings are in elements of the side they describe.
+ */
+#define TTL_IMPORT_CONVERTED_COPY __TTL_converted_import_3D
+#endif
+
+#ifndef TTL_EXPORT_CONVERTED_COPY
+/**
+ * @brief Export a 3D block converting each element, returning when complete.
+ *
+ * The lines of the block are divided between the work-items, so each element is stored to
+ * global memory once by the work-group.
+ */
+static inline event_t __TTL_converted_export_3D(__global void *const dst, const __local void *const src,
+                                                const TTL_conversion_t conversion, size_t num_elements_per_line,
+                                                size_t num_lines, size_t num_planes, size_t src_total_line_length,
+                                                size_t src_total_plane_spacing, size_t dst_total_line_length,
+                                                size_t dst_total_plane_spacing, event_t event) {
+    __TTL_convert_export_3D(dst,
+                            src,
+                            conversion,
+                            num_elements_per_line,
+                            num_lines,
+                            num_planes,
+                            src_total_line_length,
+                            src_total_plane_spacing,
+                            dst_total_line_length,
+                            dst_total_plane_spacing);
+
+    // The block is complete, and seen by every work-item, on return.
+    __TTL_global_barrier();
+
+    return event;
+}
+
+/**
+ * @def TTL_EXPORT_CONVERTED_COPY
+ *
+ * @brief The copy used to export with a conversion, as TTL_IMPORT_CONVERTED_COPY
+ */
+#define TTL_EXPORT_CONVERTED_COPY __TTL_converted_export_3D
+#endif
+
+#ifndef TTL_LOCAL_COPY_3D
+/**
+ * @brief Copy a 3D block within local memory, returning when complete.
+ *
+ * async_work_group_copy_3D3D only copies between global and local memory, so the block is
+ * copied before returning. The lines are divided into pieces of 16 bytes that are shared out
+ * between the work-items of the work-group, each copied with a vector load and store.
+ */
+static inline event_t __TTL_local_copy_3D(__local void *const dst, size_t dst_offset, const __local void *const src,
+                                          size_t src_offset, size_t num_bytes_per_element,
+                                          size_t num_elements_per_line, size_t num_lines, size_t num_planes,
+                                          size_t src_total_line_length, size_t src_total_plane_spacing,
+                                          size_t dst_total_line_length, size_t dst_total_plane_spacing,
+                                          event_t event) {
+    const size_t line_bytes = num_elements_per_line * num_bytes_per_element;
+    const size_t pieces_per_line = (line_bytes + 15) / 16;
+    const size_t pieces = pieces_per_line * num_lines * num_planes;
+
+    for (size_t piece = TTL_WORK_ITEM_ID; piece < pieces; piece += TTL_NUMBER_OF_WORK_ITEMS) {
+        const size_t line = (piece / pieces_per_line) % num_lines;
+        const size_t plane = (piece / pieces_per_line) / num_lines;
+        const size_t byte = (piece % pieces_per_line) * 16;
+        const size_t src_element = src_offset + (plane * src_total_plane_spacing) + (line * src_total_line_length);
+        const size_t dst_element = dst_offset + (plane * dst_total_plane_spacing) + (line * dst_total_line_length);
+        const __local uchar *const src_bytes =
+            (const __local uchar *)src + (src_element * num_bytes_per_element) + byte;
+        __local uchar *const dst_bytes = (__local uchar *)dst + (dst_element * num_bytes_per_element) + byte;
+
+        if ((byte + 16) <= line_bytes) {
+            vstore16(vload16(0, src_bytes), 0, dst_bytes);
+        } else {
+            for (size_t i = 0; i < (line_bytes - byte); i++) dst_bytes[i] = src_bytes[i];
+        }
+    }
+
+    // The block is complete, and seen by every work-item, on return.
+    __TTL_local_barrier();
+
+    return event;
+}
+
+/**
+ * @def TTL_LOCAL_COPY_3D
+ *
+ * @brief The copy used within local memory, a target may define it to copy asynchronously.
+ *
+ * Takes the parameters of async_work_group_copy_3D3D.
+ */
+#define TTL_LOCAL_COPY_3D __TTL_local_copy_3D
+#endif
+
+#ifndef __TTL_local_fill
+/**
+ * @brief Fill num bytes of local memory with value, 16 bytes per store.
+ */
+static inline void __TTL_vector_local_fill(__local void *const ptr, const char value, const size_t num) {
+    __local uchar *const dst = (__local uchar *)ptr;
+    const uchar16 pattern = (uchar16)((uchar)value);
+    size_t byte = 0;
+
+    for (; (byte + 16) <= num; byte += 16) vstore16(pattern, 0, dst + byte);
+    for (; byte < num; byte++) dst[byte] = value;
+}
+
+/**
+ * @def __TTL_local_fill
+ *
+ * @brief Fill num bytes of local memory at ptr with value, used to clear the padding of imports.
+ *
+ * A target may define this to use its own fill.
+ */
+#define __TTL_local_fill(ptr, value, num) __TTL_vector_local_fill(ptr, value, num)
+#endif
+
 /**
  * @brief Return an empty event of type TTL_event_t
  *
@@ -53,6 +360,113 @@ static inline void __TTL_TRACE_FN(TTL_wait, const int num_events, TTL_event_t *c
     wait_group_events(num_events, events);
 }
 
+#ifndef TTL_TEST_EVENT
+/**
+ * @brief Return true once the transfers of an event are complete, the default TTL_TEST_EVENT
+ *
+ * OpenCL C cannot ask whether an event is complete, so the event is waited for and is
+ * then complete.
+ */
+static inline bool __TTL_test_event(event_t *const event) {
+    wait_group_events(1, event);
+    *event = TTL_get_event();
+
+    return true;
+}
+
+/**
+ * @def TTL_TEST_EVENT
+ *
+ * @brief Test an event without waiting, a target that can query its events may define it.
+ */
+#define TTL_TEST_EVENT __TTL_test_event
+#endif
+
+#ifndef TTL_WAIT_ANY_EVENT
+/**
+ * @brief Wait for any one of a list of events, the default TTL_WAIT_ANY_EVENT
+ *
+ * Without a way to ask which event completes first the first event is waited for.
+ */
+static inline int __TTL_wait_any_event(int num_events, event_t *event_list) {
+    if (num_events <= 0) return -1;
+
+    wait_group_events(1, event_list);
+    event_list[0] = TTL_get_event();
+
+    return 0;
+}
+
+/**
+ * @def TTL_WAIT_ANY_EVENT
+ *
+ * @brief Wait for any one of a list of events, a target that can query its events may define it.
+ */
+#define TTL_WAIT_ANY_EVENT __TTL_wait_any_event
+#endif
+
+/**
+ * @brief Return whether the transfers of an event are complete, without waiting for them
+ *
+ * A complete event is set to the empty event, so it can be passed to the next transfer
+ * and TTL_wait returns at once for it. The empty event is always complete.
+ *
+ * Where a target cannot query its events, for example OpenCL, the event is waited for and
+ * true returned, so a kernel that polls behaves as one that waits.
+ *
+ * @param event A pointer to the event to test.
+ *
+ * @return true if the transfers of the event are complete.
+ */
+static inline bool TTL_event_test(TTL_event_t *const event) {
+    return TTL_TEST_EVENT(event);
+}
+
+/**
+ * @def TTL_wait_any
+ *
+ * @brief Wait for any one of an array of events to enter the complete state.
+ *
+ * The complete event is set to the empty event and the others are left outstanding. As the
+ * empty event is always complete, events that have already been waited for should not be
+ * passed, @see TTL_event_pool_t which keeps track of them.
+ *
+ * @return The index in events of the complete event, or -1 if num_events is 0.
+ */
+static inline int __TTL_TRACE_FN(TTL_wait_any, const int num_events, TTL_event_t *const events) {
+#if __TTL_DEBUG > 0
+    __TTL_dump_wait(num_events, events __TTL_TRACE_LINE);
+#endif  // __TTL_DEBUG
+
+    return TTL_WAIT_ANY_EVENT(num_events, events);
+}
+
+/**
+ * @brief Merge the dimensions of a copy that are contiguous in both the source and destination
+ *
+ * Planes that start where the previous plane's last line ends become further lines, and
+ * lines that start where the previous line ends become one longer line. A full width tile
+ * of a packed tensor is then copied as a single line rather than a line at a time.
+ *
+ * @param shape The shape of the copy, updated to the merged shape.
+ * @param src_layout The layout of the source.
+ * @param dst_layout The layout of the destination.
+ */
+static inline void __TTL_coalesce_copy(TTL_shape_t *const shape, const TTL_layout_t src_layout,
+                                       const TTL_layout_t dst_layout) {
+    if ((shape->depth == 1) || ((src_layout.plane_spacing == (src_layout.row_spacing * shape->height)) &&
+                                (dst_layout.plane_spacing == (dst_layout.row_spacing * shape->height)))) {
+        shape->height *= shape->depth;
+        shape->depth = 1;
+    }
+
+    if ((shape->height == 1) ||
+        ((src_layout.row_spacing == shape->width) && (dst_layout.row_spacing == shape->width))) {
+        shape->width *= shape->height;
+        shape->height = 1;
+    }
+}
+
 /**
  * @brief TTL_import
  *
@@ -65,19 +479,23 @@ static inline void __TTL_TRACE_FN(TTL_wait, const int num_events, TTL_event_t *c
 static inline void __attribute__((overloadable))
 __TTL_TRACE_FN(TTL_import_base, const TTL_int_tensor_t internal_tensor, const TTL_const_ext_tensor_t external_tensor,
                TTL_event_t *event) {
-    *event = async_work_group_copy_3D3D((__local void *)internal_tensor.base,
-                                        0,
-                                        (__global void *)external_tensor.base,
-                                        0,
-                                        internal_tensor.elem_size,
-                                        internal_tensor.shape.width,
-                                        internal_tensor.shape.height,
-                                        internal_tensor.shape.depth,
-                                        external_tensor.layout.row_spacing,
-                                        external_tensor.layout.plane_spacing,
-                                        internal_tensor.layout.row_spacing,
-                                        internal_tensor.layout.plane_spacing,
-                                        *event);
+    TTL_shape_t shape = internal_tensor.shape;
+
+    __TTL_coalesce_copy(&shape, external_tensor.layout, internal_tensor.layout);
+
+    *event = TTL_IMPORT_COPY_3D3D((__local void *)internal_tensor.base,
+                                  0,
+                                  (__global void *)external_tensor.base,
+                                  0,
+                                  internal_tensor.elem_size,
+                                  shape.width,
+                                  shape.height,
+                                  shape.depth,
+                                  external_tensor.layout.row_spacing,
+                                  external_tensor.layout.plane_spacing,
+                                  internal_tensor.layout.row_spacing,
+                                  internal_tensor.layout.plane_spacing,
+                                  *event);
 
 #if __TTL_DEBUG > 0
     __TTL_dump_transaction(false, TTL_to_const_tensor(&internal_tensor), &external_tensor, 0, event __TTL_TRACE_LINE);
@@ -98,6 +516,36 @@ static inline void __TTL_TRACE_FN(TTL_blocking_import_base, const TTL_int_tensor
     TTL_wait(1, &event __TTL_TRACE_LINE);
 }
 
+/**
+ * @brief Begin the copy of an internal tensor to another internal tensor
+ *
+ * @param dst_tensor A TTL_int_tensor_t describing the internal tensor copied to.
+ * @param src_tensor A TTL_const_int_tensor_t describing the internal tensor copied from.
+ * @param event A pointer to the event which describes the transfer.
+ *
+ * @see TTL_LOCAL_COPY_3D
+ */
+static inline void __TTL_TRACE_FN(TTL_local_copy_base, const TTL_int_tensor_t dst_tensor,
+                                  const TTL_const_int_tensor_t src_tensor, TTL_event_t *const event) {
+    TTL_shape_t shape = src_tensor.shape;
+
+    __TTL_coalesce_copy(&shape, src_tensor.layout, dst_tensor.layout);
+
+    *event = TTL_LOCAL_COPY_3D((__local void *)dst_tensor.base,
+                               0,
+                               (__local void *)src_tensor.base,
+                               0,
+                               src_tensor.elem_size,
+                               shape.width,
+                               shape.height,
+                               shape.depth,
+                               src_tensor.layout.row_spacing,
+                               src_tensor.layout.plane_spacing,
+                               dst_tensor.layout.row_spacing,
+                               dst_tensor.layout.plane_spacing,
+                               *event);
+}
+
 /**
  * @brief Begin the asynchronous export of the external tensor to the internal tensor
  *
@@ -110,19 +558,23 @@ static inline void __TTL_TRACE_FN(TTL_blocking_import_base, const TTL_int_tensor
  */
 static inline void __TTL_TRACE_FN(TTL_export_base, const TTL_const_int_tensor_t internal_tensor,
                                   const TTL_ext_tensor_t external_tensor, TTL_event_t *const event) {
-    *event = async_work_group_copy_3D3D((__global void *)external_tensor.base,
-                                        0,
-                                        (__local void *)internal_tensor.base,
-                                        0,
-                                        internal_tensor.elem_size,
-                                        internal_tensor.shape.width,
-                                        internal_tensor.shape.height,
-                                        internal_tensor.shape.depth,
-                                        internal_tensor.layout.row_spacing,
-                                        internal_tensor.layout.plane_spacing,
-                                        external_tensor.layout.row_spacing,
-                                        external_tensor.layout.plane_spacing,
-                                        *event);
+    TTL_shape_t shape = internal_tensor.shape;
+
+    __TTL_coalesce_copy(&shape, internal_tensor.layout, external_tensor.layout);
+
+    *event = TTL_EXPORT_COPY_3D3D((__global void *)external_tensor.base,
+                                  0,
+                                  (__local void *)internal_tensor.base,
+                                  0,
+                                  internal_tensor.elem_size,
+                                  shape.width,
+                                  shape.height,
+                                  shape.depth,
+                                  internal_tensor.layout.row_spacing,
+                                  internal_tensor.layout.plane_spacing,
+                                  external_tensor.layout.row_spacing,
+                                  external_tensor.layout.plane_spacing,
+                                  *event);
 
 #if __TTL_DEBUG > 0
     __TTL_dump_transaction(true, &internal_tensor, TTL_to_const_tensor(&external_tensor), 0, event __TTL_TRACE_LINE);
@@ -143,3 +595,410 @@ static inline void __TTL_TRACE_FN(TTL_blocking_export_base, const TTL_const_int_
     TTL_export_base(internal_tensor, external_tensor, &event __TTL_TRACE_LINE);
     TTL_wait(1, &event __TTL_TRACE_LINE);
 }
+
+/**
+ * @brief Return the spacing, in elements, of consecutive elements along each axis of a layout
+ */
+static inline void __TTL_axis_spacings(const TTL_layout_t layout, TTL_dim_t spacings[3]) {
+    spacings[0] = 1;
+    spacings[1] = layout.row_spacing;
+    spacings[2] = layout.plane_spacing;
+}
+
+/**
+ * @brief Begin the asynchronous import of the external tensor to the internal tensor with an axis permutation
+ *
+ * The internal tensor's axes run along the external tensor's axes given by permutation, so
+ * the internal tensor's shape is TTL_permute_shape of the external tensor's. Where x remains
+ * x the import is an ordinary 3D copy, otherwise the target's TTL_IMPORT_PERMUTED_COPY
+ * transposes the elements as they are transferred.
+ *
+ * @param internal_tensor A TTL_int_tensor_t describing the internal tensor.
+ * @param external_tensor A TTL_const_ext_tensor_t describing the external tensor.
+ * @param permutation The external axis that each internal axis runs along, @see TTL_permutation_t
+ * @param event A pointer to the event which describes the transfer.
+ */
+static inline void __TTL_TRACE_FN(TTL_import_permuted_base, const TTL_int_tensor_t internal_tensor,
+                                  const TTL_const_ext_tensor_t external_tensor, const TTL_permutation_t permutation,
+                                  TTL_event_t *const event) {
+    TTL_dim_t ext_spacings[3];
+
+    __TTL_axis_spacings(external_tensor.layout, ext_spacings);
+
+    if (permutation.x == 0) {
+        const TTL_layout_t ext_layout = TTL_create_layout(ext_spacings[permutation.y], ext_spacings[permutation.z]);
+        TTL_shape_t shape = internal_tensor.shape;
+
+        __TTL_coalesce_copy(&shape, ext_layout, internal_tensor.layout);
+
+        *event = TTL_IMPORT_COPY_3D3D((__local void *)internal_tensor.base,
+                                      0,
+                                      (__global void *)external_tensor.base,
+                                      0,
+                                      internal_tensor.elem_size,
+                                      shape.width,
+                                      shape.height,
+                                      shape.depth,
+                                      ext_layout.row_spacing,
+                                      ext_layout.plane_spacing,
+                                      internal_tensor.layout.row_spacing,
+                                      internal_tensor.layout.plane_spacing,
+                                      *event);
+    } else {
+        *event = TTL_IMPORT_PERMUTED_COPY((__local void *)internal_tensor.base,
+                                          (__global void *)external_tensor.base,
+                                          internal_tensor.elem_size,
+                                          internal_tensor.shape.width,
+                                          internal_tensor.shape.height,
+                                          internal_tensor.shape.depth,
+                                          ext_spacings[permutation.x],
+                                          ext_spacings[permutation.y],
+                                          ext_spacings[permutation.z],
+                                          internal_tensor.layout.row_spacing,
+                                          internal_tensor.layout.plane_spacing,
+                                          *event);
+    }
+
+#if __TTL_DEBUG > 0
+    __TTL_dump_transaction(false, TTL_to_const_tensor(&internal_tensor), &external_tensor, 0, event __TTL_TRACE_LINE);
+#endif  // __TTL_DEBUG
+}
+
+/**
+ * @brief Begin the asynchronous export of the internal tensor to the external tensor with an axis permutation
+ *
+ * The reverse of TTL_import_permuted_base, the same permutation returns an imported tensor
+ * to the external axis order.
+ *
+ * @param internal_tensor A TTL_const_int_tensor_t describing the internal tensor.
+ * @param external_tensor A TTL_ext_tensor_t describing the external tensor.
+ * @param permutation The external axis that each internal axis runs along, @see TTL_permutation_t
+ * @param event A pointer to the event which describes the transfer.
+ */
+static inline void __TTL_TRACE_FN(TTL_export_permuted_base, const TTL_const_int_tensor_t internal_tensor,
+                                  const TTL_ext_tensor_t external_tensor, const TTL_permutation_t permutation,
+                                  TTL_event_t *const event) {
+    TTL_dim_t ext_spacings[3];
+
+    __TTL_axis_spacings(external_tensor.layout, ext_spacings);
+
+    if (permutation.x == 0) {
+        const TTL_layout_t ext_layout = TTL_create_layout(ext_spacings[permutation.y], ext_spacings[permutation.z]);
+        TTL_shape_t shape = internal_tensor.shape;
+
+        __TTL_coalesce_copy(&shape, internal_tensor.layout, ext_layout);
+
+        *event = TTL_EXPORT_COPY_3D3D((__global void *)external_tensor.base,
+                                      0,
+                                      (__local void *)internal_tensor.base,
+                                      0,
+                                      internal_tensor.elem_size,
+                                      shape.width,
+                                      shape.height,
+                                      shape.depth,
+                                      internal_tensor.layout.row_spacing,
+                                      internal_tensor.layout.plane_spacing,
+                                      ext_layout.row_spacing,
+                                      ext_layout.plane_spacing,
+                                      *event);
+    } else {
+        *event = TTL_EXPORT_PERMUTED_COPY((__global void *)external_tensor.base,
+                                          (__local void *)internal_tensor.base,
+                                          internal_tensor.elem_size,
+                                          internal_tensor.shape.width,
+                                          internal_tensor.shape.height,
+                                          internal_tensor.shape.depth,
+                                          internal_tensor.layout.row_spacing,
+                                          internal_tensor.layout.plane_spacing,
+                                          ext_spacings[permutation.x],
+                                          ext_spacings[permutation.y],
+                                          ext_spacings[permutation.z],
+                                          *event);
+    }
+
+#if __TTL_DEBUG > 0
+    __TTL_dump_transaction(true, &internal_tensor, TTL_to_const_tensor(&external_tensor), 0, event __TTL_TRACE_LINE);
+#endif  // __TTL_DEBUG
+}
+
+/**
+ * @brief Begin the asynchronous import of the external tensor to the internal tensor converting each element
+ *
+ * The conversion's src_type must be the external tensor's element type and its dst_type the
+ * internal tensor's, the typed TTL_import_convert sets them. An empty conversion is an ordinary
+ * TTL_import_base.
+ *
+ * @param internal_tensor A TTL_int_tensor_t describing the internal tensor.
+ * @param external_tensor A TTL_const_ext_tensor_t describing the external tensor.
+ * @param conversion The conversion applied to each element, @see TTL_conversion_t
+ * @param event A pointer to the event which describes the transfer.
+ */
+static inline void __TTL_TRACE_FN(TTL_import_convert_base, const TTL_int_tensor_t internal_tensor,
+                                  const TTL_const_ext_tensor_t external_tensor, const TTL_conversion_t conversion,
+                                  TTL_event_t *const event) {
+    if (TTL_conversion_empty(conversion)) {
+        TTL_import_base(internal_tensor, external_tensor, event __TTL_TRACE_LINE);
+        return;
+    }
+
+    TTL_shape_t shape = internal_tensor.shape;
+
+    __TTL_coalesce_copy(&shape, external_tensor.layout, internal_tensor.layout);
+
+    *event = TTL_IMPORT_CONVERTED_COPY((__local void *)internal_tensor.base,
+                                       (__global void *)external_tensor.base,
+                                       conversion,
+                                       shape.width,
+                                       shape.height,
+                                       shape.depth,
+                                       external_tensor.layout.row_spacing,
+                                       external_tensor.layout.plane_spacing,
+                                       internal_tensor.layout.row_spacing,
+                                       internal_tensor.layout.plane_spacing,
+                                       *event);
+
+#if __TTL_DEBUG > 0
+    __TTL_dump_transaction(false, TTL_to_const_tensor(&internal_tensor), &external_tensor, 0, event __TTL_TRACE_LINE);
+#endif  // __TTL_DEBUG
+}
+
+/**
+ * @brief Begin the asynchronous export of the internal tensor to the external tensor converting each element
+ *
+ * The conversion's src_type must be the internal tensor's element type and its dst_type the
+ * external tensor's, the typed TTL_export_convert sets them. An empty conversion is an ordinary
+ * TTL_export_base.
+ *
+ * @param internal_tensor A TTL_const_int_tensor_t describing the internal tensor.
+ * @param external_tensor A TTL_ext_tensor_t describing the external tensor.
+ * @param conversion The conversion applied to each element, @see TTL_conversion_t
+ * @param event A pointer to the event which describes the transfer.
+ */
+static inline void __TTL_TRACE_FN(TTL_export_convert_base, const TTL_const_int_tensor_t internal_tensor,
+                                  const TTL_ext_tensor_t external_tensor, const TTL_conversion_t conversion,
+                                  TTL_event_t *const event) {
+    if (TTL_conversion_empty(conversion)) {
+        TTL_export_base(internal_tensor, external_tensor, event __TTL_TRACE_LINE);
+        return;
+    }
+
+    TTL_shape_t shape = internal_tensor.shape;
+
+    __TTL_coalesce_copy(&shape, internal_tensor.layout, external_tensor.layout);
+
+    *event = TTL_EXPORT_CONVERTED_COPY((__global void *)external_tensor.base,
+                                       (__local void *)internal_tensor.base,
+                                       conversion,
+                                       shape.width,
+                                       shape.height,
+                                       shape.depth,
+                                       internal_tensor.layout.row_spacing,
+                                       internal_tensor.layout.plane_spacing,
+                                       external_tensor.layout.row_spacing,
+                                       external_tensor.layout.plane_spacing,
+                                       *event);
+
+#if __TTL_DEBUG > 0
+    __TTL_dump_transaction(true, &internal_tensor, TTL_to_const_tensor(&external_tensor), 0, event __TTL_TRACE_LINE);
+#endif  // __TTL_DEBUG
+}
+
+/**
+ * @def TTL_COPY_BATCH_SIZE
+ *
+ * @brief The number of copies a TTL_copy_batch_t can hold.
+ */
+#ifndef TTL_COPY_BATCH_SIZE
+#define TTL_COPY_BATCH_SIZE 8
+#endif
+
+/**
+ * @def TTL_COPY_BATCH_BEGIN
+ *
+ * @brief Called before the copies of a batch are issued, a target may define it to
+ * collect the copies and start them together at TTL_COPY_BATCH_END.
+ */
+#ifndef TTL_COPY_BATCH_BEGIN
+#define TTL_COPY_BATCH_BEGIN()
+#endif
+
+/**
+ * @def TTL_COPY_BATCH_END
+ *
+ * @brief Called after the copies of a batch are issued, @see TTL_COPY_BATCH_BEGIN
+ */
+#ifndef TTL_COPY_BATCH_END
+#define TTL_COPY_BATCH_END()
+#endif
+
+/**
+ * @brief Description of a copy held by a TTL_copy_batch_t
+ *
+ * The shape has already been coalesced, @see __TTL_coalesce_copy
+ */
+typedef struct {
+    TTL_local(void *) int_base;   ///< Base of the internal tensor
+    TTL_global(void *) ext_base;  ///< Base of the external tensor
+    TTL_dim_t elem_size;          ///< The size of the elements
+    TTL_shape_t shape;            ///< The shape copied
+    TTL_layout_t int_layout;      ///< The layout of the internal tensor
+    TTL_layout_t ext_layout;      ///< The layout of the external tensor
+    bool is_export;               ///< Copy from the internal to the external tensor
+} TTL_copy_descriptor_t;
+
+/**
+ * @brief A list of copies issued together against a single event by TTL_submit_batch
+ *
+ * Kernels that import or export several small tensors per tile can then wait once for
+ * all of them, and targets that chain descriptors can start them as one transfer.
+ *
+ * Example:
+ * @code
+ * TTL_copy_batch_t batch = TTL_create_copy_batch();
+ * TTL_batch_import(&batch, weights_int_tensor, weights_ext_tensor);
+ * TTL_batch_import(&batch, lut_int_tensor, lut_ext_tensor);
+ * TTL_event_t event = TTL_get_event();
+ * TTL_submit_batch(&batch, &event);
+ * TTL_wait(1, &event);
+ * @endcode
+ */
+typedef struct {
+    unsigned int count;                                      ///< The number of copies held
+    TTL_copy_descriptor_t descriptors[TTL_COPY_BATCH_SIZE];  ///< The copies, in the order added
+} TTL_copy_batch_t;
+
+/**
+ * @brief Create an empty TTL_copy_batch_t
+ */
+static inline TTL_copy_batch_t TTL_create_copy_batch(__TTL_NO_PARAMETERS) {
+    TTL_copy_batch_t result;
+
+    result.count = 0;
+
+    return result;
+}
+
+/**
+ * @brief Add a copy to a batch, returning false if the batch is full.
+ */
+static inline bool __TTL_batch_add(TTL_copy_batch_t *const batch, TTL_local(void *) const int_base,
+                                   TTL_global(void *) const ext_base, const TTL_dim_t elem_size,
+                                   const TTL_shape_t shape, const TTL_layout_t int_layout,
+                                   const TTL_layout_t ext_layout, const bool is_export) {
+    if (TTL_shape_empty(shape)) return true;
+
+    if (batch->count == TTL_COPY_BATCH_SIZE) return false;
+
+    TTL_copy_descriptor_t *const descriptor = &batch->descriptors[batch->count++];
+
+    descriptor->int_base = int_base;
+    descriptor->ext_base = ext_base;
+    descriptor->elem_size = elem_size;
+    descriptor->shape = shape;
+    descriptor->int_layout = int_layout;
+    descriptor->ext_layout = ext_layout;
+    descriptor->is_export = is_export;
+
+    __TTL_coalesce_copy(&descriptor->shape, ext_layout, int_layout);
+
+    return true;
+}
+
+/**
+ * @brief Add the import of the external tensor to the internal tensor to a batch
+ *
+ * @param batch The batch to add the import to.
+ * @param internal_tensor A TTL_int_tensor_t describing the internal tensor.
+ * @param external_tensor A TTL_const_ext_tensor_t describing the external tensor.
+ *
+ * @return false, leaving the batch unchanged, if the batch is full.
+ */
+static inline bool TTL_batch_import_base(TTL_copy_batch_t *const batch, const TTL_int_tensor_t internal_tensor,
+                                         const TTL_const_ext_tensor_t external_tensor) {
+    return __TTL_batch_add(batch,
+                           (__local void *)internal_tensor.base,
+                           (__global void *)external_tensor.base,
+                           internal_tensor.elem_size,
+                           internal_tensor.shape,
+                           internal_tensor.layout,
+                           external_tensor.layout,
+                           false);
+}
+
+/**
+ * @brief Add the export of the internal tensor to the external tensor to a batch
+ *
+ * @param batch The batch to add the export to.
+ * @param internal_tensor A TTL_const_int_tensor_t describing the internal tensor.
+ * @param external_tensor A TTL_ext_tensor_t describing the external tensor.
+ *
+ * @return false, leaving the batch unchanged, if the batch is full.
+ */
+static inline bool TTL_batch_export_base(TTL_copy_batch_t *const batch, const TTL_const_int_tensor_t internal_tensor,
+                                         const TTL_ext_tensor_t external_tensor) {
+    return __TTL_batch_add(batch,
+                           (__local void *)internal_tensor.base,
+                           (__global void *)external_tensor.base,
+                           internal_tensor.elem_size,
+                           internal_tensor.shape,
+                           internal_tensor.layout,
+                           external_tensor.layout,
+                           true);
+}
+
+/**
+ * @brief Begin every copy of a batch, signalling a single event on completion
+ *
+ * The copies are issued in the order they were added and the batch is emptied so
+ * that it can be reused.
+ *
+ * @param batch The batch to submit.
+ * @param event A pointer to the event which describes the transfers.
+ */
+static inline void __TTL_TRACE_FN(TTL_submit_batch, TTL_copy_batch_t *const batch, TTL_event_t *const event) {
+    TTL_COPY_BATCH_BEGIN();
+
+    for (unsigned int i = 0; i < batch->count; i++) {
+        const TTL_copy_descriptor_t *const descriptor = &batch->descriptors[i];
+
+        if (descriptor->is_export) {
+            *event = TTL_EXPORT_COPY_3D3D(descriptor->ext_base,
+                                          0,
+                                          descriptor->int_base,
+                                          0,
+                                          descriptor->elem_size,
+                                          descriptor->shape.width,
+                                          descriptor->shape.height,
+                                          descriptor->shape.depth,
+                                          descriptor->int_layout.row_spacing,
+                                          descriptor->int_layout.plane_spacing,
+                                          descriptor->ext_layout.row_spacing,
+                                          descriptor->ext_layout.plane_spacing,
+                                          *event);
+        } else {
+            *event = TTL_IMPORT_COPY_3D3D(descriptor->int_base,
+                                          0,
+                                          descriptor->ext_base,
+                                          0,
+                                          descriptor->elem_size,
+                                          descriptor->shape.width,
+                                          descriptor->shape.height,
+                                          descriptor->shape.depth,
+                                          descriptor->ext_layout.row_spacing,
+                                          descriptor->ext_layout.plane_spacing,
+                                          descriptor->int_layout.row_spacing,
+                                          descriptor->int_layout.plane_spacing,
+                                          *event);
+        }
+    }
+
+    TTL_COPY_BATCH_END();
+
+#if __TTL_DEBUG > 0
+    printf("TTL_SUBMIT_BATCH: %u copies ", batch->count);
+    __TTL_dump_event(event);
+    printf("\n       line: %d\n", line);
+#endif  // __TTL_DEBUG
+
+    batch->count = 0;
+}
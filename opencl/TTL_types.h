@@ -87,6 +87,59 @@ typedef int TTL_offset_dim_t;    ///< The type used to hold offsets and origins.
  */
 #define TTL_local_printf "%p"
 
+#ifndef TTL_GROUP_ID
+/**
+ * @def TTL_GROUP_ID
+ *
+ * @brief The work-group of the calling work-item, @see TTL_create_group_tile_partition
+ *
+ * Work-groups are counted along the first dimension of the NDRange.
+ */
+#define TTL_GROUP_ID get_group_id(0)
+#endif
+
+#ifndef TTL_NUMBER_OF_GROUPS
+/**
+ * @def TTL_NUMBER_OF_GROUPS
+ *
+ * @brief The number of work-groups the tiles are divided between, @see TTL_create_group_tile_partition
+ */
+#define TTL_NUMBER_OF_GROUPS get_num_groups(0)
+#endif
+
+#ifndef TTL_WORK_ITEM_ID
+/**
+ * @def TTL_WORK_ITEM_ID
+ *
+ * @brief The position of the calling work-item in its work-group, counting every dimension.
+ */
+#define TTL_WORK_ITEM_ID \
+    ((((get_local_id(2) * get_local_size(1)) + get_local_id(1)) * get_local_size(0)) + get_local_id(0))
+#endif
+
+#ifndef TTL_NUMBER_OF_WORK_ITEMS
+/**
+ * @def TTL_NUMBER_OF_WORK_ITEMS
+ *
+ * @brief The number of work-items in the work-group of the calling work-item.
+ */
+#define TTL_NUMBER_OF_WORK_ITEMS (get_local_size(0) * get_local_size(1) * get_local_size(2))
+#endif
+
+#ifndef __TTL_local_barrier
+/**
+ * @brief Wait for every work-item of the work-group, after which their writes to local memory are seen by all.
+ */
+#define __TTL_local_barrier() barrier(CLK_LOCAL_MEM_FENCE)
+#endif
+
+#ifndef __TTL_global_barrier
+/**
+ * @brief Wait for every work-item of the work-group, after which their writes to global memory are seen by all.
+ */
+#define __TTL_global_barrier() barrier(CLK_GLOBAL_MEM_FENCE)
+#endif
+
 /**
  * @brief TTL_event_t is a pseudonym for OpenCL event_t
  *
@@ -66,6 +66,13 @@ __kernel void TTL_double_buffering(__global TEST_TENSOR_TYPE *restrict ext_base_
     const TTL_shape_t tensor_shape_out = TTL_create_shape(width, height);
     const TTL_tiler_t output_tiler = TTL_create_tiler(tensor_shape_out, TTL_create_shape(tile_width, tile_height));
 
+    // The tiles processed by this work-group, the input and output tilers have the same number of tiles.
+    const TTL_tile_partition_t input_partition = TTL_create_group_tile_partition(input_tiler, TTL_PARTITION_CONTIGUOUS);
+    const TTL_tile_partition_t output_partition =
+        TTL_create_group_tile_partition(output_tiler, TTL_PARTITION_CONTIGUOUS);
+    TTL_tile_iterator_t input_tiles = TTL_create_partition_tile_iterator(input_tiler, input_partition);
+    TTL_tile_iterator_t output_tiles = TTL_create_partition_tile_iterator(output_tiler, output_partition);
+
     // External layouts.
     const TTL_layout_t ext_layout_in = TTL_create_layout(external_stride_in);
     const TTL_layout_t ext_layout_out = TTL_create_layout(external_stride_out);
@@ -78,20 +85,23 @@ __kernel void TTL_double_buffering(__global TEST_TENSOR_TYPE *restrict ext_base_
     // they record the event to wait on
     TTL_event_t import_DB_e = TTL_get_event();
     TTL_IMPORT_DOUBLE_BUFFERING_TYPE import_db = TTL_start_import_double_buffering(
-        input_buffer_1, input_buffer_2, ext_input_tensor, &import_DB_e, TTL_get_tile(0, input_tiler));
+        input_buffer_1, input_buffer_2, ext_input_tensor, &import_DB_e, TTL_current_tile(&input_tiles));
 
     TTL_event_t export_DB_e = TTL_get_event();
     TTL_EXPORT_DOUBLE_BUFFERING_TYPE export_db =
         TTL_start_export_double_buffering(output_buffer_1, output_buffer_2, ext_output_tensor, &export_DB_e);
 
-    for (int i = 0; i < TTL_number_of_tiles(input_tiler); ++i) {
-        TTL_tile_t tile_next_import = TTL_get_tile(i + 1, input_tiler);
-        TTL_tile_t tile_current_export = TTL_get_tile(i, output_tiler);
+    for (int i = 0; i < input_partition.number_of_tiles; ++i) {
+        TTL_tile_t tile_next_import = TTL_look_ahead_tile(&input_tiles);
+        TTL_tile_t tile_current_export = TTL_current_tile(&output_tiles);
 
         TTL_INT_SUB_TENSOR_TYPE imported_to = TTL_step_buffering(&import_db, tile_next_import);
         TTL_INT_SUB_TENSOR_TYPE exported_from = TTL_step_buffering(&export_db, tile_current_export);
 
         compute(imported_to, exported_from);
+
+        TTL_advance_tile_iterator(&input_tiles);
+        TTL_advance_tile_iterator(&output_tiles);
     }
 
     TTL_finish_buffering(&import_db);
@@ -28,6 +28,10 @@
 
 test_definition test_list[] = {
     ADD_TEST(ttl),
+    ADD_TEST(ttl_boundary),
+    ADD_TEST(ttl_gather_scatter),
+    ADD_TEST(ttl_permuted),
+    ADD_TEST(ttl_convert),
 };
 
 const int test_num = ARRAY_SIZE(test_list);
@@ -21,3 +21,7 @@
 #include "harness/typeWrappers.h"
 
 extern int test_ttl(cl_device_id deviceID, cl_context context, cl_command_queue queue, int num_elements);
+extern int test_ttl_boundary(cl_device_id deviceID, cl_context context, cl_command_queue queue, int num_elements);
+extern int test_ttl_gather_scatter(cl_device_id deviceID, cl_context context, cl_command_queue queue, int num_elements);
+extern int test_ttl_permuted(cl_device_id deviceID, cl_context context, cl_command_queue queue, int num_elements);
+extern int test_ttl_convert(cl_device_id deviceID, cl_context context, cl_command_queue queue, int num_elements);
@@ -19,6 +19,7 @@
 #include <sys/stat.h>
 #include <sys/types.h>
 
+#include <algorithm>
 #include <random>
 #include <vector>
 
@@ -126,6 +127,100 @@ static const char *ttlDoubleBufferingKernel = R"(
 }
 )";
 
+// The lines of each tile are divided between the work-items, so that the halo copies of TTL_reuse_halo
+// are made by several work-items.
+static const char *computeWorkItemsFunction = R"(
+void compute(TTL_int_uchar_sub_tensor_t tensor_in, TTL_int_uchar_sub_tensor_t tensor_out) {
+    for (int y = get_local_id(0); y < tensor_out.tensor.shape.height; y += get_local_size(0)) {
+        for (int x = 0; x < tensor_out.tensor.shape.width; ++x) {
+            const int x_in = x + TILE_OVERLAP_LEFT;
+            const int y_in = y + TILE_OVERLAP_TOP;
+            const uchar left = TTL_read_tensor(tensor_in, x_in - 1, y_in);
+            const uchar above = TTL_read_tensor(tensor_in, x_in, y_in - 1);
+            const uchar centre = TTL_read_tensor(tensor_in, x_in, y_in);
+            const uchar right = TTL_read_tensor(tensor_in, x_in + 1, y_in);
+            const uchar bottom = TTL_read_tensor(tensor_in, x_in, y_in + 1);
+
+            TTL_write_tensor(tensor_out, left + above + centre + right + bottom, x, y);
+        }
+    }
+
+    barrier(CLK_LOCAL_MEM_FENCE);
+}
+)";
+
+static const char *ttlReuseHaloKernel = R"(
+#define TTL_COPY_3D
+#include "%s/TTL.h"
+
+#define TILE_OVERLAP_LEFT % d
+#define TILE_OVERLAP_RIGHT % d
+#define TILE_OVERLAP_TOP % d
+#define TILE_OVERLAP_BOTTOM % d
+
+% s
+#define MEMSZ 0x8000
+
+        __kernel void
+        TTL_reuse_halo(__global uchar *restrict ext_base_in, int external_stride_in,
+                       __global uchar *restrict ext_base_out, int external_stride_out, int width, int height,
+                       int tile_width, int tile_height) {
+    local uchar l_in1[MEMSZ];
+    local uchar l_in2[MEMSZ];
+    local uchar l_out1[MEMSZ];
+    local uchar l_out2[MEMSZ];
+
+    // Logical input tiling, consecutive tiles sharing their overlap.
+    const TTL_shape_t tensor_shape_in = TTL_create_shape(width, height);
+    const TTL_shape_t tile_shape_in = TTL_create_shape(tile_width + (TILE_OVERLAP_LEFT + TILE_OVERLAP_RIGHT),
+                                                       tile_height + (TILE_OVERLAP_TOP + TILE_OVERLAP_BOTTOM));
+    const TTL_overlap_t overlap_in =
+        TTL_create_overlap(TILE_OVERLAP_LEFT + TILE_OVERLAP_RIGHT, TILE_OVERLAP_TOP + TILE_OVERLAP_BOTTOM);
+    const TTL_augmentation_t augmentation_in =
+        TTL_create_augmentation(TILE_OVERLAP_LEFT, TILE_OVERLAP_RIGHT, TILE_OVERLAP_TOP, TILE_OVERLAP_BOTTOM);
+    const TTL_tiler_t input_tiler =
+        TTL_create_overlap_tiler(tensor_shape_in, tile_shape_in, overlap_in, augmentation_in);
+
+    // Logical output tiling.
+    const TTL_shape_t tensor_shape_out = TTL_create_shape(width, height);
+    const TTL_tiler_t output_tiler = TTL_create_tiler(tensor_shape_out, TTL_create_shape(tile_width, tile_height));
+
+    // External layouts.
+    const TTL_layout_t ext_layout_in = TTL_create_layout(external_stride_in);
+    const TTL_layout_t ext_layout_out = TTL_create_layout(external_stride_out);
+
+    const TTL_const_ext_uchar_tensor_t ext_input_tensor =
+        TTL_create_const_ext_tensor(ext_base_in, tensor_shape_in, ext_layout_in);
+    const TTL_ext_uchar_tensor_t ext_output_tensor =
+        TTL_create_ext_tensor(ext_base_out, tensor_shape_out, ext_layout_out);
+
+    TTL_event_t import_DB_e = TTL_get_event();
+    TTL_import_double_const_uchar_tensor_buffering_t import_db =
+        TTL_start_import_double_buffering(l_in1, l_in2, ext_input_tensor, &import_DB_e, TTL_get_tile(0, input_tiler));
+
+    // Copy the overlap of each tile with the one before from the previous buffer, the compute only
+    // reads the imported tiles.
+    TTL_reuse_halo(&import_db);
+
+    TTL_event_t export_DB_e = TTL_get_event();
+    TTL_export_double_const_uchar_tensor_buffering_t export_db =
+        TTL_start_export_double_buffering(l_out1, l_out2, ext_output_tensor, &export_DB_e);
+
+    for (int i = 0; i < TTL_number_of_tiles(input_tiler); ++i) {
+        TTL_tile_t t_next = TTL_get_tile(i + 1, input_tiler);
+        TTL_int_uchar_sub_tensor_t imported_to = TTL_step_buffering(&import_db, t_next);
+
+        TTL_tile_t t_curr = TTL_get_tile(i, output_tiler);
+        TTL_int_uchar_sub_tensor_t exported_from = TTL_step_buffering(&export_db, t_curr);
+
+        compute(imported_to, exported_from);
+    }
+
+    TTL_finish_buffering(&import_db);
+    TTL_finish_buffering(&export_db);
+}
+)";
+
 static const char *ttlSimplexBufferingKernel = R"(
 #define TTL_COPY_3D
 #include "%s/TTL.h"
@@ -254,6 +349,169 @@ static const char *ttlDuplexBufferingKernel = R"(
     TTL_finish_buffering(&duplex_scheme);
 }
 )";
+
+static const char *ttlBoundaryKernel = R"(
+#define TTL_COPY_3D
+#include "%s/TTL.h"
+
+#define MEMSZ 0x8000
+
+        __kernel void
+        TTL_boundary(__global uchar *restrict ext_base_in, int width, int height, __global uchar *restrict ext_base_out,
+                     int tile_width, int tile_height, int augmentation, int mirror) {
+    local uchar l_in1[MEMSZ];
+    local uchar l_in2[MEMSZ];
+
+    // Logical input tiling, the tiles augmented on every side with the repeated or reflected tensor.
+    const TTL_shape_t tensor_shape = TTL_create_shape(width, height);
+    const TTL_shape_t tile_shape = TTL_create_shape(tile_width + (2 * augmentation), tile_height + (2 * augmentation));
+    const TTL_overlap_t overlap = TTL_create_overlap(2 * augmentation, 2 * augmentation);
+    const TTL_boundary_t boundary = TTL_create_boundary(mirror ? TTL_BOUNDARY_MIRROR : TTL_BOUNDARY_REPLICATE);
+    const TTL_augmentation_t tile_augmentation =
+        TTL_create_augmentation(augmentation, augmentation, augmentation, augmentation, boundary);
+    const TTL_tiler_t input_tiler = TTL_create_overlap_tiler(tensor_shape, tile_shape, overlap, tile_augmentation);
+
+    const TTL_const_ext_uchar_tensor_t ext_input_tensor =
+        TTL_create_const_ext_tensor(ext_base_in, tensor_shape, TTL_create_layout(width));
+
+    TTL_event_t import_DB_e = TTL_get_event();
+    TTL_import_double_const_uchar_tensor_buffering_t import_db =
+        TTL_start_import_double_buffering(l_in1, l_in2, ext_input_tensor, &import_DB_e, TTL_get_tile(0, input_tiler));
+
+    // The output is the tensor with its augmentation, each tile writes all of the elements it imported.
+    const int output_stride = width + (2 * augmentation);
+
+    for (int i = 0; i < TTL_number_of_tiles(input_tiler); ++i) {
+        TTL_tile_t t_next = TTL_get_tile(i + 1, input_tiler);
+        TTL_int_uchar_sub_tensor_t imported_to = TTL_step_buffering(&import_db, t_next);
+        const TTL_offset_t offset = imported_to.origin.sub_offset;
+
+        for (int y = 0; y < imported_to.tensor.shape.height; ++y) {
+            for (int x = 0; x < imported_to.tensor.shape.width; ++x) {
+                ext_base_out[((offset.y + augmentation + y) * output_stride) + offset.x + augmentation + x] =
+                    TTL_read_tensor(imported_to, x, y);
+            }
+        }
+    }
+
+    TTL_finish_buffering(&import_db);
+}
+)";
+
+static const char *ttlGatherScatterKernel = R"(
+#define TTL_COPY_3D
+#include "%s/TTL.h"
+
+#define MEMSZ 0x4000
+#define MAX_INDICES 256
+
+        __kernel void
+        TTL_gather_scatter(__global uchar *restrict table, int width, int table_rows, __global int *restrict indices,
+                           int index_count, __global uchar *restrict gathered, __global uchar *restrict rows,
+                           __global uchar *restrict scattered) {
+    local int l_indices[MAX_INDICES];
+    local uchar l_gathered[MEMSZ];
+    local uchar l_rows[MEMSZ];
+
+    // The internal tensors have two more rows than there are indices, which map to no external row.
+    const TTL_shape_t table_shape = TTL_create_shape(width, table_rows);
+    const TTL_shape_t rows_shape = TTL_create_shape(width, index_count + 2);
+
+    for (int i = get_local_id(0); i < index_count; i += get_local_size(0)) l_indices[i] = indices[i];
+
+    // The rows the gather does not import must be zeroed by it.
+    for (int i = get_local_id(0); i < (width * (index_count + 2)); i += get_local_size(0)) l_gathered[i] = 0xff;
+
+    barrier(CLK_LOCAL_MEM_FENCE);
+
+    const TTL_const_int_int_tensor_t index_tensor =
+        TTL_create_const_int_tensor(l_indices, TTL_create_shape(index_count));
+    const TTL_int_uchar_tensor_t gathered_to = TTL_create_int_tensor(l_gathered, rows_shape);
+    const TTL_int_uchar_tensor_t rows_to = TTL_create_int_tensor(l_rows, rows_shape);
+
+    TTL_event_t event = TTL_get_event();
+    TTL_import_gather(gathered_to, TTL_create_const_ext_tensor(table, table_shape), index_tensor, &event);
+    TTL_import(rows_to, TTL_create_const_ext_tensor(rows, rows_shape), &event);
+    TTL_wait(1, &event);
+
+    TTL_export(gathered_to, TTL_create_ext_tensor(gathered, rows_shape), &event);
+    TTL_export_scatter(rows_to, TTL_create_ext_tensor(scattered, table_shape), index_tensor, &event);
+    TTL_wait(1, &event);
+}
+)";
+
+static const char *ttlPermutedKernel = R"(
+#define TTL_COPY_3D
+#include "%s/TTL.h"
+
+#define ELEMENT %s
+#define MEMSZ 0x4000
+
+#define __TENSOR_T(prefix, type) prefix##type##_tensor_t
+#define TENSOR_T(prefix, type) __TENSOR_T(prefix, type)
+
+        __kernel void
+        TTL_permuted(__global ELEMENT *restrict ext_base_in, int width, int height, int depth, int row_spacing,
+                     int plane_spacing, __global ELEMENT *restrict ext_base_imported,
+                     __global ELEMENT *restrict ext_base_out, int x_axis, int y_axis) {
+    local ELEMENT l_permuted[MEMSZ / sizeof(ELEMENT)];
+
+    const TTL_permutation_t permutation = TTL_create_permutation(x_axis, y_axis, 3 - (x_axis + y_axis));
+    const TTL_shape_t shape = TTL_create_shape(width, height, depth);
+    const TTL_layout_t layout = TTL_create_layout(row_spacing, plane_spacing);
+    const TTL_shape_t permuted_shape = TTL_permute_shape(shape, permutation);
+    const TENSOR_T(TTL_int_, ELEMENT) permuted = TTL_create_int_tensor(l_permuted, permuted_shape);
+
+    TTL_event_t event = TTL_get_event();
+    TTL_import_permuted(permuted, TTL_create_const_ext_tensor(ext_base_in, shape, layout), permutation, &event);
+    TTL_wait(1, &event);
+
+    // The internal tensor is exported as it is, and with the permutation back to the external axis order.
+    TTL_export(permuted, TTL_create_ext_tensor(ext_base_imported, permuted_shape), &event);
+    TTL_export_permuted(permuted, TTL_create_ext_tensor(ext_base_out, shape, layout), permutation, &event);
+    TTL_wait(1, &event);
+}
+)";
+
+static const char *ttlConvertKernel = R"(
+#define TTL_COPY_3D
+#include "%s/TTL.h"
+
+#define MEMSZ 0x2000
+
+        __kernel void
+        TTL_convert(__global short *restrict ext_base_in, int width, int height, int scale_quarters, int zero_point,
+                    __global uchar *restrict ext_base_saturated, __global char *restrict ext_base_quantised,
+                    __global short *restrict ext_base_dequantised, __global char *restrict ext_base_narrowed) {
+    local uchar l_saturated[MEMSZ];
+    local char l_quantised[MEMSZ];
+    local short l_in[MEMSZ / sizeof(short)];
+
+    const TTL_shape_t shape = TTL_create_shape(width, height);
+    const float scale = scale_quarters / 4.0f;
+    const TTL_const_ext_short_tensor_t ext_input_tensor = TTL_create_const_ext_tensor(ext_base_in, shape);
+    const TTL_int_uchar_tensor_t saturated = TTL_create_int_tensor(l_saturated, shape);
+    const TTL_int_char_tensor_t quantised = TTL_create_int_tensor(l_quantised, shape);
+    const TTL_int_short_tensor_t in = TTL_create_int_tensor(l_in, shape);
+
+    // Import narrowing with saturation, quantising, and without a conversion.
+    TTL_event_t event = TTL_get_event();
+    TTL_import_convert(saturated, ext_input_tensor, TTL_create_conversion(), &event);
+    TTL_import_convert(quantised, ext_input_tensor, TTL_create_quantisation(scale, zero_point), &event);
+    TTL_import(in, ext_input_tensor, &event);
+    TTL_wait(1, &event);
+
+    // Export the imports as they are, dequantising, and narrowing with saturation.
+    TTL_export(saturated, TTL_create_ext_tensor(ext_base_saturated, shape), &event);
+    TTL_export(quantised, TTL_create_ext_tensor(ext_base_quantised, shape), &event);
+    TTL_export_convert(quantised,
+                       TTL_create_ext_tensor(ext_base_dequantised, shape),
+                       TTL_create_dequantisation(scale, zero_point),
+                       &event);
+    TTL_export_convert(in, TTL_create_ext_tensor(ext_base_narrowed, shape), TTL_create_conversion(), &event);
+    TTL_wait(1, &event);
+}
+)";
 // clang-format on
 
 bool resultCheck(unsigned char *const extBaseIn, unsigned char *const extBaseOut, const int tensorWidth,
@@ -294,6 +552,55 @@ bool resultCheck(unsigned char *const extBaseIn, unsigned char *const extBaseOut
     return success;
 }
 
+// The element of a dimension of size elements that position outside of it takes its value from.
+static int boundarySource(int position, const int size, const bool mirror) {
+    const int last = size - 1;
+
+    while ((position < 0) || (position > last)) {
+        if (mirror && (last > 0)) {
+            position = position < 0 ? -position : (2 * last) - position;
+        } else {
+            position = position < 0 ? 0 : last;
+        }
+    }
+
+    return position;
+}
+
+bool boundaryCheck(unsigned char *const extBaseIn, unsigned char *const extBaseOut, const int tensorWidth,
+                   const int tensorHeight, const int tileWidth, const int tileHeight, const int augmentation,
+                   const bool mirror) {
+    const int outputWidth = tensorWidth + (2 * augmentation);
+    const int outputHeight = tensorHeight + (2 * augmentation);
+    bool success = true;
+
+    for (int y = 0; (y < outputHeight) && success; y++) {
+        for (int x = 0; (x < outputWidth) && success; x++) {
+            const int sourceX = boundarySource(x - augmentation, tensorWidth, mirror);
+            const int sourceY = boundarySource(y - augmentation, tensorHeight, mirror);
+            const uint8_t expected = extBaseIn[(sourceY * tensorWidth) + sourceX];
+
+            if (extBaseOut[(y * outputWidth) + x] != expected) {
+                log_info("test_ttl_boundary failed at [%d, %d] %d != %d "
+                         "Tensor size [%d, %d], Tile size [%d, %d], Augmentation %d, %s\n",
+                         y - augmentation,
+                         x - augmentation,
+                         extBaseOut[(y * outputWidth) + x],
+                         expected,
+                         tensorWidth,
+                         tensorHeight,
+                         tileWidth,
+                         tileHeight,
+                         augmentation,
+                         mirror ? "TTL_BOUNDARY_MIRROR" : "TTL_BOUNDARY_REPLICATE");
+                success = false;
+            }
+        }
+    }
+
+    return success;
+}
+
 class random_list : public std::vector<uint32_t> {
 public:
     random_list(const uint32_t lowest, uint32_t const highest, const uint32_t count, std::vector<uint32_t> start_vector)
@@ -309,7 +616,8 @@ public:
 };
 
 static int test_ttl_all_types(cl_device_id deviceID, cl_context context, cl_command_queue queue,
-                              const char *const kernelCode, const char *computeFunction, const char *const kernelName) {
+                              const char *const kernelCode, const char *computeFunction, const char *const kernelName,
+                              const size_t workItems = 1) {
     int error;
     clProgramWrapper program;
     clKernelWrapper kernel;
@@ -383,8 +691,8 @@ static int test_ttl_all_types(cl_device_id deviceID, cl_context context, cl_comm
             uint8_t *const outBuffer = new uint8_t[globalBufferSize];
             memset(outBuffer, 0, globalBufferSize);
 
-            threads[0] = 1;       // globalWorkgroupSize;
-            localThreads[0] = 1;  // localWorkgroupSize;
+            threads[0] = workItems < max_workgroup_size ? workItems : max_workgroup_size;  // globalWorkgroupSize;
+            localThreads[0] = threads[0];                                                  // localWorkgroupSize;
 
             {
                 const MTdata d = init_genrand(gRandomSeed);
@@ -456,7 +764,567 @@ int test_ttl(cl_device_id deviceID, cl_context context, cl_command_queue queue,
             (test_ttl_all_types(
                  deviceID, context, queue, ttlSimplexBufferingKernel, computeFunction, "TTL_simplex_buffering") == 0) &&
             (test_ttl_all_types(
-                 deviceID, context, queue, ttlDuplexBufferingKernel, computeFunction, "TTL_duplex_buffering") == 0))
+                 deviceID, context, queue, ttlDuplexBufferingKernel, computeFunction, "TTL_duplex_buffering") == 0) &&
+            (test_ttl_all_types(
+                 deviceID, context, queue, ttlReuseHaloKernel, computeWorkItemsFunction, "TTL_reuse_halo", 16) == 0))
+               ? 0
+               : -1;
+}
+
+int test_ttl_boundary(cl_device_id deviceID, cl_context context, cl_command_queue queue, int num_elements) {
+    int error;
+    clProgramWrapper program;
+    clKernelWrapper kernel;
+    size_t threads[1] = { 1 };
+    size_t localThreads[1] = { 1 };
+    bool failuresPrinted = false;
+
+    log_info("Testing TTL_boundary\n");
+
+    char programSource[10240] = { 0 };
+    char *programPtr;
+
+    sprintf(programSource, ttlBoundaryKernel, STR(TTL_INSTALL_DIR));
+    programPtr = programSource;
+
+    error = create_single_kernel_helper(context, &program, &kernel, 1, (const char **)&programPtr, "TTL_boundary");
+    test_error(error, "Unable to create testing kernel");
+
+    // Tensors of a single element in a dimension reflect to that element, and augmentations wider than
+    // the tensor repeat or reflect it more than once.
+    for (uint32_t tensorWidth : random_list(1, 125, 5, { 1, 2 })) {
+        for (uint32_t tensorHeight : random_list(1, 125, 5, { 1, 2 })) {
+            const size_t globalBufferSize = tensorWidth * tensorHeight;
+            uint8_t *const inBuffer = new uint8_t[globalBufferSize];
+
+            {
+                const MTdata d = init_genrand(gRandomSeed);
+                generate_random_data(kUChar, globalBufferSize, d, inBuffer);
+                free_mtdata(d);
+            }
+
+            clMemWrapper input_stream =
+                clCreateBuffer(context, CL_MEM_COPY_HOST_PTR, globalBufferSize, inBuffer, &error);
+            test_error(error, "Unable to create input buffer");
+
+            for (int32_t augmentation : { 1, 3, 20 }) {
+                const size_t outputBufferSize =
+                    (tensorWidth + (2 * augmentation)) * (tensorHeight + (2 * augmentation));
+                uint8_t *const outBuffer = new uint8_t[outputBufferSize];
+
+                clMemWrapper output_stream = clCreateBuffer(context, CL_MEM_READ_WRITE, outputBufferSize, NULL, &error);
+                test_error(error, "Unable to create output buffer");
+
+                for (int32_t mirror : { 0, 1 }) {
+                    for (uint32_t tileWidth : random_list(1, tensorWidth, 3, { 1, tensorWidth })) {
+                        for (uint32_t tileHeight : random_list(1, tensorHeight, 3, { 1, tensorHeight })) {
+                            error = clSetKernelArg(kernel, 0, sizeof(input_stream), &input_stream);
+                            test_error(error, "Unable to set kernel argument");
+                            error = clSetKernelArg(kernel, 1, sizeof(tensorWidth), &tensorWidth);
+                            test_error(error, "Unable to set kernel argument");
+                            error = clSetKernelArg(kernel, 2, sizeof(tensorHeight), &tensorHeight);
+                            test_error(error, "Unable to set kernel argument");
+                            error = clSetKernelArg(kernel, 3, sizeof(output_stream), &output_stream);
+                            test_error(error, "Unable to set kernel argument");
+                            error = clSetKernelArg(kernel, 4, sizeof(tileWidth), &tileWidth);
+                            test_error(error, "Unable to set kernel argument");
+                            error = clSetKernelArg(kernel, 5, sizeof(tileHeight), &tileHeight);
+                            test_error(error, "Unable to set kernel argument");
+                            error = clSetKernelArg(kernel, 6, sizeof(augmentation), &augmentation);
+                            test_error(error, "Unable to set kernel argument");
+                            error = clSetKernelArg(kernel, 7, sizeof(mirror), &mirror);
+                            test_error(error, "Unable to set kernel argument");
+
+                            cl_event completion_event;
+
+                            // Enqueue
+                            error = clEnqueueNDRangeKernel(
+                                queue, kernel, 1, NULL, threads, localThreads, 0, NULL, &completion_event);
+                            test_error(error, "Unable to queue kernel");
+                            error = clWaitForEvents(1, &completion_event);
+                            test_error(error, "Unable to wait for kernel");
+
+                            // Read
+                            cl_event read_buffer_event;
+                            error = clEnqueueReadBuffer(queue,
+                                                        output_stream,
+                                                        CL_TRUE,
+                                                        0,
+                                                        outputBufferSize,
+                                                        outBuffer,
+                                                        0,
+                                                        NULL,
+                                                        &read_buffer_event);
+                            test_error(error, "Unable to read results");
+                            error = clWaitForEvents(1, &read_buffer_event);
+                            test_error(error, "Unable to wait for read buffer");
+
+                            if (boundaryCheck(inBuffer,
+                                              outBuffer,
+                                              tensorWidth,
+                                              tensorHeight,
+                                              tileWidth,
+                                              tileHeight,
+                                              augmentation,
+                                              mirror) == false) {
+                                failuresPrinted = true;
+                            }
+                        }
+                    }
+                }
+
+                delete[] outBuffer;
+            }
+
+            delete[] inBuffer;
+        }
+    }
+
+    return failuresPrinted ? -1 : 0;
+}
+
+// Runs of consecutive rows of the table in a random order, with indices of no row before, between and after them.
+static std::vector<int32_t> gatherIndices(const int32_t tableRows, std::mt19937 &gen) {
+    std::vector<std::vector<int32_t>> runs;
+
+    for (int32_t row = 0; row < tableRows;) {
+        const int32_t length = std::min(tableRows - row, (int32_t)std::uniform_int_distribution<>(1, 6)(gen));
+        std::vector<int32_t> run;
+
+        for (int32_t i = 0; i < length; i++) run.push_back(row++);
+        runs.push_back(run);
+    }
+
+    for (const int32_t invalid : { -1, -2, tableRows, tableRows + 7 }) runs.push_back({ invalid });
+    runs.push_back({ -1, tableRows });
+
+    std::shuffle(runs.begin(), runs.end(), gen);
+
+    std::vector<int32_t> indices;
+
+    for (const std::vector<int32_t> &run : runs) indices.insert(indices.end(), run.begin(), run.end());
+
+    return indices;
+}
+
+int test_ttl_gather_scatter(cl_device_id deviceID, cl_context context, cl_command_queue queue, int num_elements) {
+    int error;
+    clProgramWrapper program;
+    clKernelWrapper kernel;
+    size_t threads[1] = { 1 };
+    size_t localThreads[1] = { 1 };
+    bool failuresPrinted = false;
+
+    log_info("Testing TTL_gather_scatter\n");
+
+    char programSource[10240] = { 0 };
+    char *programPtr;
+
+    sprintf(programSource, ttlGatherScatterKernel, STR(TTL_INSTALL_DIR));
+    programPtr = programSource;
+
+    error =
+        create_single_kernel_helper(context, &program, &kernel, 1, (const char **)&programPtr, "TTL_gather_scatter");
+    test_error(error, "Unable to create testing kernel");
+
+    std::random_device rd;
+    std::mt19937 gen(rd());
+
+    for (uint32_t width : random_list(1, 64, 5, { 1 })) {
+        for (int32_t tableRows : random_list(1, 100, 5, { 1 })) {
+            const std::vector<int32_t> indices = gatherIndices(tableRows, gen);
+            const int32_t indexCount = indices.size();
+            const size_t tableSize = width * tableRows;
+            const size_t rowsSize = width * (indexCount + 2);
+            std::vector<uint8_t> table(tableSize), rows(rowsSize), initial(tableSize);
+            std::vector<uint8_t> gathered(rowsSize), scattered(tableSize);
+
+            {
+                const MTdata d = init_genrand(gRandomSeed);
+                generate_random_data(kUChar, tableSize, d, table.data());
+                generate_random_data(kUChar, rowsSize, d, rows.data());
+                generate_random_data(kUChar, tableSize, d, initial.data());
+                free_mtdata(d);
+            }
+
+            clMemWrapper table_stream =
+                clCreateBuffer(context, CL_MEM_COPY_HOST_PTR, tableSize, table.data(), &error);
+            test_error(error, "Unable to create table buffer");
+            clMemWrapper index_stream = clCreateBuffer(
+                context, CL_MEM_COPY_HOST_PTR, indexCount * sizeof(int32_t), (void *)indices.data(), &error);
+            test_error(error, "Unable to create index buffer");
+            clMemWrapper gathered_stream = clCreateBuffer(context, CL_MEM_READ_WRITE, rowsSize, NULL, &error);
+            test_error(error, "Unable to create gathered buffer");
+            clMemWrapper rows_stream = clCreateBuffer(context, CL_MEM_COPY_HOST_PTR, rowsSize, rows.data(), &error);
+            test_error(error, "Unable to create rows buffer");
+            clMemWrapper scattered_stream =
+                clCreateBuffer(context, CL_MEM_COPY_HOST_PTR, tableSize, initial.data(), &error);
+            test_error(error, "Unable to create scattered buffer");
+
+            error = clSetKernelArg(kernel, 0, sizeof(table_stream), &table_stream);
+            test_error(error, "Unable to set kernel argument");
+            error = clSetKernelArg(kernel, 1, sizeof(width), &width);
+            test_error(error, "Unable to set kernel argument");
+            error = clSetKernelArg(kernel, 2, sizeof(tableRows), &tableRows);
+            test_error(error, "Unable to set kernel argument");
+            error = clSetKernelArg(kernel, 3, sizeof(index_stream), &index_stream);
+            test_error(error, "Unable to set kernel argument");
+            error = clSetKernelArg(kernel, 4, sizeof(indexCount), &indexCount);
+            test_error(error, "Unable to set kernel argument");
+            error = clSetKernelArg(kernel, 5, sizeof(gathered_stream), &gathered_stream);
+            test_error(error, "Unable to set kernel argument");
+            error = clSetKernelArg(kernel, 6, sizeof(rows_stream), &rows_stream);
+            test_error(error, "Unable to set kernel argument");
+            error = clSetKernelArg(kernel, 7, sizeof(scattered_stream), &scattered_stream);
+            test_error(error, "Unable to set kernel argument");
+
+            cl_event completion_event;
+
+            // Enqueue
+            error =
+                clEnqueueNDRangeKernel(queue, kernel, 1, NULL, threads, localThreads, 0, NULL, &completion_event);
+            test_error(error, "Unable to queue kernel");
+            error = clWaitForEvents(1, &completion_event);
+            test_error(error, "Unable to wait for kernel");
+
+            // Read
+            error = clEnqueueReadBuffer(
+                queue, gathered_stream, CL_TRUE, 0, rowsSize, gathered.data(), 0, NULL, NULL);
+            test_error(error, "Unable to read results");
+            error = clEnqueueReadBuffer(
+                queue, scattered_stream, CL_TRUE, 0, tableSize, scattered.data(), 0, NULL, NULL);
+            test_error(error, "Unable to read results");
+
+            // Each row with a valid index is gathered from and scattered to the table row it names, the other
+            // rows are gathered as zeros and not scattered.
+            std::vector<uint8_t> expectedGathered(rowsSize, 0), expectedScattered(initial);
+
+            for (int32_t row = 0; row < indexCount; row++) {
+                const int32_t index = indices[row];
+
+                if ((index >= 0) && (index < tableRows)) {
+                    memcpy(&expectedGathered[row * width], &table[index * width], width);
+                    memcpy(&expectedScattered[index * width], &rows[row * width], width);
+                }
+            }
+
+            if ((gathered != expectedGathered) || (scattered != expectedScattered)) {
+                log_info("test_ttl_gather_scatter failed to %s Table size [%d, %d], %d indices\n",
+                         gathered != expectedGathered ? "gather" : "scatter",
+                         width,
+                         tableRows,
+                         indexCount);
+                failuresPrinted = true;
+            }
+        }
+    }
+
+    return failuresPrinted ? -1 : 0;
+}
+
+template <typename T>
+static int test_ttl_permuted_type(cl_device_id deviceID, cl_context context, cl_command_queue queue,
+                                  const char *const typeName) {
+    int error;
+    clProgramWrapper program;
+    clKernelWrapper kernel;
+    size_t threads[1] = { 1 };
+    size_t localThreads[1] = { 1 };
+    bool failuresPrinted = false;
+
+    log_info("Testing TTL_permuted with %s\n", typeName);
+
+    char programSource[10240] = { 0 };
+    char *programPtr;
+
+    sprintf(programSource, ttlPermutedKernel, STR(TTL_INSTALL_DIR), typeName);
+    programPtr = programSource;
+
+    error = create_single_kernel_helper(context, &program, &kernel, 1, (const char **)&programPtr, "TTL_permuted");
+    test_error(error, "Unable to create testing kernel");
+
+    // Sizes above 16 are copied by the C target in more than one block along an axis. The external
+    // tensor has padding at the end of its lines and planes, which the exports must not write.
+    for (int32_t width : random_list(1, 40, 3, { 1, 17 })) {
+        for (int32_t height : random_list(1, 40, 3, { 1, 17 })) {
+            for (int32_t depth : { 1, 2 }) {
+                const int32_t rowSpacing = width + 3;
+                const int32_t planeSpacing = rowSpacing * (height + 1);
+                const size_t externalCount = planeSpacing * depth;
+                const size_t permutedCount = width * height * depth;
+                std::vector<T> input(externalCount), initial(externalCount);
+                std::vector<T> imported(permutedCount), output(externalCount);
+
+                {
+                    const MTdata d = init_genrand(gRandomSeed);
+                    generate_random_data(kUChar, externalCount * sizeof(T), d, input.data());
+                    generate_random_data(kUChar, externalCount * sizeof(T), d, initial.data());
+                    free_mtdata(d);
+                }
+
+                clMemWrapper input_stream = clCreateBuffer(
+                    context, CL_MEM_COPY_HOST_PTR, externalCount * sizeof(T), input.data(), &error);
+                test_error(error, "Unable to create input buffer");
+                clMemWrapper imported_stream =
+                    clCreateBuffer(context, CL_MEM_READ_WRITE, permutedCount * sizeof(T), NULL, &error);
+                test_error(error, "Unable to create imported buffer");
+
+                // Each permutation as the external axes that the internal x and y axes run along.
+                static const int32_t permutationAxes[][2] = { { 0, 1 }, { 1, 0 }, { 0, 2 },
+                                                              { 2, 0 }, { 1, 2 }, { 2, 1 } };
+
+                for (const auto &axes : permutationAxes) {
+                    const int32_t permutation[3] = { axes[0], axes[1], 3 - (axes[0] + axes[1]) };
+                    const int32_t dims[3] = { width, height, depth };
+
+                    clMemWrapper output_stream = clCreateBuffer(
+                        context, CL_MEM_COPY_HOST_PTR, externalCount * sizeof(T), initial.data(), &error);
+                    test_error(error, "Unable to create output buffer");
+
+                    error = clSetKernelArg(kernel, 0, sizeof(input_stream), &input_stream);
+                    test_error(error, "Unable to set kernel argument");
+                    error = clSetKernelArg(kernel, 1, sizeof(width), &width);
+                    test_error(error, "Unable to set kernel argument");
+                    error = clSetKernelArg(kernel, 2, sizeof(height), &height);
+                    test_error(error, "Unable to set kernel argument");
+                    error = clSetKernelArg(kernel, 3, sizeof(depth), &depth);
+                    test_error(error, "Unable to set kernel argument");
+                    error = clSetKernelArg(kernel, 4, sizeof(rowSpacing), &rowSpacing);
+                    test_error(error, "Unable to set kernel argument");
+                    error = clSetKernelArg(kernel, 5, sizeof(planeSpacing), &planeSpacing);
+                    test_error(error, "Unable to set kernel argument");
+                    error = clSetKernelArg(kernel, 6, sizeof(imported_stream), &imported_stream);
+                    test_error(error, "Unable to set kernel argument");
+                    error = clSetKernelArg(kernel, 7, sizeof(output_stream), &output_stream);
+                    test_error(error, "Unable to set kernel argument");
+                    error = clSetKernelArg(kernel, 8, sizeof(permutation[0]), &permutation[0]);
+                    test_error(error, "Unable to set kernel argument");
+                    error = clSetKernelArg(kernel, 9, sizeof(permutation[1]), &permutation[1]);
+                    test_error(error, "Unable to set kernel argument");
+
+                    cl_event completion_event;
+
+                    // Enqueue
+                    error = clEnqueueNDRangeKernel(
+                        queue, kernel, 1, NULL, threads, localThreads, 0, NULL, &completion_event);
+                    test_error(error, "Unable to queue kernel");
+                    error = clWaitForEvents(1, &completion_event);
+                    test_error(error, "Unable to wait for kernel");
+
+                    // Read
+                    error = clEnqueueReadBuffer(
+                        queue, imported_stream, CL_TRUE, 0, permutedCount * sizeof(T), imported.data(), 0, NULL, NULL);
+                    test_error(error, "Unable to read results");
+                    error = clEnqueueReadBuffer(
+                        queue, output_stream, CL_TRUE, 0, externalCount * sizeof(T), output.data(), 0, NULL, NULL);
+                    test_error(error, "Unable to read results");
+
+                    // Element (x, y, z) of the imported tensor is the external element whose coordinate along
+                    // each permuted axis is the internal one.
+                    std::vector<T> expectedImported(permutedCount), expectedOutput(initial);
+                    const int32_t permutedWidth = dims[permutation[0]];
+                    const int32_t permutedHeight = dims[permutation[1]];
+
+                    for (int32_t z = 0; z < depth; z++) {
+                        for (int32_t y = 0; y < height; y++) {
+                            for (int32_t x = 0; x < width; x++) {
+                                const int32_t external[3] = { x, y, z };
+                                const size_t element = (z * planeSpacing) + (y * rowSpacing) + x;
+
+                                expectedImported[(((external[permutation[2]] * permutedHeight) +
+                                                   external[permutation[1]]) *
+                                                  permutedWidth) +
+                                                 external[permutation[0]]] = input[element];
+                                expectedOutput[element] = input[element];
+                            }
+                        }
+                    }
+
+                    if ((imported != expectedImported) || (output != expectedOutput)) {
+                        log_info("test_ttl_permuted failed to %s Tensor size [%d, %d, %d], Permutation [%d, %d, %d], "
+                                 "%s\n",
+                                 imported != expectedImported ? "import" : "export",
+                                 width,
+                                 height,
+                                 depth,
+                                 permutation[0],
+                                 permutation[1],
+                                 permutation[2],
+                                 typeName);
+                        failuresPrinted = true;
+                    }
+                }
+            }
+        }
+    }
+
+    return failuresPrinted ? -1 : 0;
+}
+
+int test_ttl_permuted(cl_device_id deviceID, cl_context context, cl_command_queue queue, int num_elements) {
+    return ((test_ttl_permuted_type<uint8_t>(deviceID, context, queue, "uchar") == 0) &&
+            (test_ttl_permuted_type<uint16_t>(deviceID, context, queue, "ushort") == 0) &&
+            (test_ttl_permuted_type<uint32_t>(deviceID, context, queue, "uint") == 0))
                ? 0
                : -1;
 }
+
+// Round half away from zero then saturate to [min, max], as the conversions do.
+static long convertedValue(const float value, const long min, const long max) {
+    const long rounded = (long)(value + (value < 0 ? -0.5f : 0.5f));
+
+    return rounded < min ? min : rounded > max ? max : rounded;
+}
+
+int test_ttl_convert(cl_device_id deviceID, cl_context context, cl_command_queue queue, int num_elements) {
+    int error;
+    clProgramWrapper program;
+    clKernelWrapper kernel;
+    size_t threads[1], localThreads[1];
+    bool failuresPrinted = false;
+
+    log_info("Testing TTL_convert\n");
+
+    char programSource[10240] = { 0 };
+    char *programPtr;
+
+    sprintf(programSource, ttlConvertKernel, STR(TTL_INSTALL_DIR));
+    programPtr = programSource;
+
+    error = create_single_kernel_helper(context, &program, &kernel, 1, (const char **)&programPtr, "TTL_convert");
+    test_error(error, "Unable to create testing kernel");
+
+    size_t max_workgroup_size;
+    error = clGetKernelWorkGroupInfo(
+        kernel, deviceID, CL_KERNEL_WORK_GROUP_SIZE, sizeof(max_workgroup_size), &max_workgroup_size, NULL);
+    test_error(error, "clGetKernelWorkGroupInfo failed for CL_KERNEL_WORK_GROUP_SIZE.");
+
+    // The lines of a converting transfer are divided between the work-items.
+    threads[0] = 8 < max_workgroup_size ? 8 : max_workgroup_size;
+    localThreads[0] = threads[0];
+
+    // Widths above 64 are converted in more than one chunk.
+    for (int32_t width : random_list(1, 100, 4, { 1, 65 })) {
+        for (int32_t height : random_list(1, 20, 3, { 1 })) {
+            const size_t count = width * height;
+            std::vector<int16_t> input(count), dequantised(count);
+            std::vector<uint8_t> saturated(count);
+            std::vector<int8_t> quantised(count), narrowed(count);
+
+            {
+                const MTdata d = init_genrand(gRandomSeed);
+                generate_random_data(kUChar, count * sizeof(int16_t), d, input.data());
+                free_mtdata(d);
+            }
+
+            // Values at the limits of each type, and small values that quantise to halves.
+            static const int16_t limits[] = { -32768, 32767, -129, -128, 127, 128, 255, 256, -1, 0, 1, -5, 5, -6, 6 };
+
+            for (size_t i = 0; (i < count) && (i < (sizeof(limits) / sizeof(limits[0]))); i++) input[i] = limits[i];
+
+            clMemWrapper input_stream =
+                clCreateBuffer(context, CL_MEM_COPY_HOST_PTR, count * sizeof(int16_t), input.data(), &error);
+            test_error(error, "Unable to create input buffer");
+            clMemWrapper saturated_stream = clCreateBuffer(context, CL_MEM_READ_WRITE, count, NULL, &error);
+            test_error(error, "Unable to create saturated buffer");
+            clMemWrapper quantised_stream = clCreateBuffer(context, CL_MEM_READ_WRITE, count, NULL, &error);
+            test_error(error, "Unable to create quantised buffer");
+            clMemWrapper dequantised_stream =
+                clCreateBuffer(context, CL_MEM_READ_WRITE, count * sizeof(int16_t), NULL, &error);
+            test_error(error, "Unable to create dequantised buffer");
+            clMemWrapper narrowed_stream = clCreateBuffer(context, CL_MEM_READ_WRITE, count, NULL, &error);
+            test_error(error, "Unable to create narrowed buffer");
+
+            // Scales that are powers of two are exact in float, so the results do not depend on the
+            // device's rounding of intermediate values.
+            for (int32_t scaleQuarters : { 1, 2, 4, 8, 16 }) {
+                for (int32_t zeroPoint : { 0, -3, 10 }) {
+                    error = clSetKernelArg(kernel, 0, sizeof(input_stream), &input_stream);
+                    test_error(error, "Unable to set kernel argument");
+                    error = clSetKernelArg(kernel, 1, sizeof(width), &width);
+                    test_error(error, "Unable to set kernel argument");
+                    error = clSetKernelArg(kernel, 2, sizeof(height), &height);
+                    test_error(error, "Unable to set kernel argument");
+                    error = clSetKernelArg(kernel, 3, sizeof(scaleQuarters), &scaleQuarters);
+                    test_error(error, "Unable to set kernel argument");
+                    error = clSetKernelArg(kernel, 4, sizeof(zeroPoint), &zeroPoint);
+                    test_error(error, "Unable to set kernel argument");
+                    error = clSetKernelArg(kernel, 5, sizeof(saturated_stream), &saturated_stream);
+                    test_error(error, "Unable to set kernel argument");
+                    error = clSetKernelArg(kernel, 6, sizeof(quantised_stream), &quantised_stream);
+                    test_error(error, "Unable to set kernel argument");
+                    error = clSetKernelArg(kernel, 7, sizeof(dequantised_stream), &dequantised_stream);
+                    test_error(error, "Unable to set kernel argument");
+                    error = clSetKernelArg(kernel, 8, sizeof(narrowed_stream), &narrowed_stream);
+                    test_error(error, "Unable to set kernel argument");
+
+                    cl_event completion_event;
+
+                    // Enqueue
+                    error = clEnqueueNDRangeKernel(
+                        queue, kernel, 1, NULL, threads, localThreads, 0, NULL, &completion_event);
+                    test_error(error, "Unable to queue kernel");
+                    error = clWaitForEvents(1, &completion_event);
+                    test_error(error, "Unable to wait for kernel");
+
+                    // Read
+                    error = clEnqueueReadBuffer(
+                        queue, saturated_stream, CL_TRUE, 0, count, saturated.data(), 0, NULL, NULL);
+                    test_error(error, "Unable to read results");
+                    error = clEnqueueReadBuffer(
+                        queue, quantised_stream, CL_TRUE, 0, count, quantised.data(), 0, NULL, NULL);
+                    test_error(error, "Unable to read results");
+                    error = clEnqueueReadBuffer(queue,
+                                                dequantised_stream,
+                                                CL_TRUE,
+                                                0,
+                                                count * sizeof(int16_t),
+                                                dequantised.data(),
+                                                0,
+                                                NULL,
+                                                NULL);
+                    test_error(error, "Unable to read results");
+                    error = clEnqueueReadBuffer(
+                        queue, narrowed_stream, CL_TRUE, 0, count, narrowed.data(), 0, NULL, NULL);
+                    test_error(error, "Unable to read results");
+
+                    const float scale = scaleQuarters / 4.0f;
+
+                    for (size_t i = 0; (i < count) && (failuresPrinted == false); i++) {
+                        const long expectedSaturated = convertedValue(input[i], 0, UINT8_MAX);
+                        const long expectedQuantised =
+                            convertedValue((input[i] * (1.0f / scale)) + zeroPoint, INT8_MIN, INT8_MAX);
+                        const long expectedDequantised = convertedValue(
+                            (quantised[i] * scale) - (zeroPoint * scale), INT16_MIN, INT16_MAX);
+                        const long expectedNarrowed = convertedValue(input[i], INT8_MIN, INT8_MAX);
+
+                        if ((saturated[i] != expectedSaturated) || (quantised[i] != expectedQuantised) ||
+                            (dequantised[i] != expectedDequantised) || (narrowed[i] != expectedNarrowed)) {
+                            log_info("test_ttl_convert failed at [%d, %d] for %d, saturated %d != %ld, quantised %d != "
+                                     "%ld, dequantised %d != %ld, narrowed %d != %ld Tensor size [%d, %d], Scale %f, "
+                                     "Zero point %d\n",
+                                     (int)(i / width),
+                                     (int)(i % width),
+                                     input[i],
+                                     saturated[i],
+                                     expectedSaturated,
+                                     quantised[i],
+                                     expectedQuantised,
+                                     dequantised[i],
+                                     expectedDequantised,
+                                     narrowed[i],
+                                     expectedNarrowed,
+                                     width,
+                                     height,
+                                     scale,
+                                     zeroPoint);
+                            failuresPrinted = true;
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    return failuresPrinted ? -1 : 0;
+}
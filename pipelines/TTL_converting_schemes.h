@@ -0,0 +1,102 @@
+/*
+ * TTL_converting_schemes.h
+ *
+ * Copyright (c) 2023 Mobileye
+ *
+ * Licensed under the Apache License, Version 2.0 (the License);
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file
+ *
+ * Double buffering with internal buffers of a different element type to the external tensor.
+ *
+ * Each tile is converted as it is imported or exported, so for example a uchar image can be
+ * processed in short buffers and the result narrowed back to uchar, or quantised values
+ * dequantised on their way in. The buffering types are those of the internal element type.
+ *
+ * Example:
+ * @code
+ * TTL_import_double_const_short_tensor_buffering_t import_db = TTL_start_import_double_buffering(
+ *       l_in1, l_in2, ext_uchar_tensor, &import_DB_e, TTL_get_tile(0, tiler), TTL_create_conversion());
+ * @endcode
+ */
+
+#pragma once
+
+// This file presumes that the following have been pre included.
+// this is not done here for path reasons.
+// #include "TTL_core.h"
+// #include "TTL_import_export.h"
+// #include TTL_IMPORT_EXPORT_INCLUDE_H
+#include "../TTL_macros.h"
+#include "../TTL_types.h"
+
+/**
+ * @def __TTL_create_converting_double_buffering
+ *
+ * @brief Create the converting TTL_start_import_double_buffering and TTL_start_export_double_buffering
+ * for an internal and an external element type.
+ */
+#define __TTL_create_converting_double_buffering(ext_type, ext_element_type, int_type, int_element_type)           \
+    /**                                                                                                           \
+     * @brief Create a TTL_import_double_buffering_t converting each element, and begin importing first_tile     \
+     *                                                                                                            \
+     * @param conversion The conversion applied to each element, its element types are set from the tensors     \
+     *                                                                                                            \
+     * @see TTL_start_import_double_buffering for the other parameters                                           \
+     */                                                                                                           \
+    static inline __TTL_tensor_name(TTL_import_double_, const_, , int_type, , _buffering_t)                       \
+        __attribute__((overloadable)) __TTL_TRACE_FN(TTL_start_import_double_buffering,                           \
+                                                     TTL_local(int_type *) int_base1,                             \
+                                                     TTL_local(int_type *) int_base2,                             \
+                                                     __TTL_tensor_name(TTL_, const_, ext_, ext_type, , _t)        \
+                                                         ext_tensor,                                              \
+                                                     TTL_event_t *event,                                          \
+                                                     TTL_tile_t first_tile,                                       \
+                                                     TTL_conversion_t conversion) {                               \
+        conversion.src_type = ext_element_type;                                                                   \
+        conversion.dst_type = int_element_type;                                                                   \
+        return __TTL_start_import_double_buffering(                                                               \
+            int_base1, int_base2, *TTL_to_void_tensor(&ext_tensor), event, first_tile, conversion __TTL_TRACE_LINE); \
+    }                                                                                                             \
+                                                                                                                  \
+    /**                                                                                                           \
+     * @brief Create a TTL_export_double_buffering_t converting each element                                     \
+     *                                                                                                            \
+     * @param conversion The conversion applied to each element, its element types are set from the tensors     \
+     *                                                                                                            \
+     * @see TTL_start_export_double_buffering for the other parameters                                           \
+     */                                                                                                           \
+    static inline __TTL_tensor_name(TTL_export_double_, const_, , int_type, , _buffering_t)                       \
+        __attribute__((overloadable)) __TTL_TRACE_FN(TTL_start_export_double_buffering,                           \
+                                                     TTL_local(int_type *) int_base1,                             \
+                                                     TTL_local(int_type *) int_base2,                             \
+                                                     __TTL_tensor_name(TTL_, , ext_, ext_type, , _t) ext_tensor,  \
+                                                     TTL_event_t *event,                                          \
+                                                     TTL_conversion_t conversion) {                               \
+        conversion.src_type = int_element_type;                                                                   \
+        conversion.dst_type = ext_element_type;                                                                   \
+        return __TTL_start_export_double_buffering(                                                               \
+            int_base1, int_base2, *TTL_to_void_tensor(&ext_tensor), event, conversion __TTL_TRACE_LINE);          \
+    }
+
+// __TTL_for_each_element_type cannot be nested, so the internal types are listed here.
+__TTL_for_each_element_type(__TTL_create_converting_double_buffering, char, TTL_ELEMENT_CHAR)
+__TTL_for_each_element_type(__TTL_create_converting_double_buffering, uchar, TTL_ELEMENT_UCHAR)
+__TTL_for_each_element_type(__TTL_create_converting_double_buffering, short, TTL_ELEMENT_SHORT)
+__TTL_for_each_element_type(__TTL_create_converting_double_buffering, ushort, TTL_ELEMENT_USHORT)
+__TTL_for_each_element_type(__TTL_create_converting_double_buffering, int, TTL_ELEMENT_INT)
+__TTL_for_each_element_type(__TTL_create_converting_double_buffering, uint, TTL_ELEMENT_UINT)
+__TTL_for_each_element_type(__TTL_create_converting_double_buffering, long, TTL_ELEMENT_LONG)
+__TTL_for_each_element_type(__TTL_create_converting_double_buffering, ulong, TTL_ELEMENT_ULONG)
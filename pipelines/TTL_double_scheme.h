@@ -31,61 +31,208 @@
 #include "TTL_double_scheme_template.h"
 
 /**
- * @brief Wait for the previous import operation to complete before beginning an
- * import of the next tile.
- *
- * @param db TTL_import_double_buffering_t describing the attributes of the
- * transfer
- * @param next_tile A description of the tile to begin importing.
+ * @brief Implementation of the TTL_step_buffering for import double buffering
  *
+ * The next tile is gathered using next_indices unless it is empty, @see TTL_import_gather
  */
 static inline TTL_INT_SUB_TENSOR_TYPE __attribute__((overloadable))
-__TTL_TRACE_FN(TTL_step_buffering, TTL_IMPORT_DOUBLE_BUFFERING_TYPE *const db, const TTL_tile_t next_tile) {
+__TTL_TRACE_FN(__TTL_step_double_buffering, TTL_IMPORT_DOUBLE_BUFFERING_TYPE *const db, const TTL_tile_t next_tile,
+               const TTL_const_int_int_tensor_t next_indices) {
     // For performance, compute everything possible before waiting for the
     // previous operations to finish.
-    const TTL_layout_t int_layout = TTL_create_layout(next_tile.shape.width, next_tile.shape.height);
-    const TTL_INT_SUB_TENSOR_TYPE import_to = TTL_create_int_sub_tensor(
-        db->common.int_base[db->common.index], next_tile.shape, int_layout, db->common.ext_tensor_in, next_tile.offset);
+    const bool gather = TTL_shape_empty(next_indices.shape) == false;
+    const bool convert = TTL_conversion_empty(db->conversion) == false;
+    const TTL_dim_t int_elem_size =
+        convert ? TTL_element_size(db->conversion.dst_type) : db->common.ext_tensor_in.elem_size;
+    const TTL_layout_t int_layout = TTL_create_packed_layout(next_tile.shape);
+    TTL_INT_SUB_TENSOR_TYPE import_to = TTL_create_int_sub_tensor(db->common.int_base[db->common.index],
+                                                                  next_tile.shape,
+                                                                  int_layout,
+                                                                  int_elem_size,
+                                                                  TTL_create_offset(),
+                                                                  db->common.ext_tensor_in.shape,
+                                                                  next_tile.offset);
+    import_to.origin.boundary = next_tile.boundary;
     const TTL_CONST_EXT_TENSOR_TYPE import_from = TTL_create_const_ext_tensor(db->common.ext_tensor_in.base,
                                                                               next_tile.shape,
                                                                               db->common.ext_tensor_in.layout,
                                                                               next_tile.offset,
                                                                               db->common.ext_tensor_in.elem_size);
 
+    TTL_padding_cache_t *const padding_cache = &db->padding_cache[db->common.index];
+
+    // The previous tile, in the other buffer, from which its halo can be copied.
+    const TTL_CONST_INT_SUB_TENSOR_TYPE prev_imported =
+        TTL_create_const_int_sub_tensor(db->common.int_base[(db->common.index + 1) % 2],
+                                        db->prev_tile.shape,
+                                        TTL_create_packed_layout(db->prev_tile.shape),
+                                        int_elem_size,
+                                        TTL_create_offset(),
+                                        db->common.ext_tensor_in.shape,
+                                        db->prev_tile.offset);
+    // A gathered tile holds rows from anywhere in the external tensor, so shares no halo.
+    const bool reuse_halo = db->reuse_halo && TTL_shape_empty(db->prev_indices.shape);
+
     TTL_wait(1, db->event __TTL_TRACE_LINE);
 
     if (TTL_tile_empty(next_tile) == false) {
-        TTL_import_sub_tensor(import_to, import_from, db->event __TTL_TRACE_LINE);
+        if (gather) {
+            // Rows come from anywhere in the external tensor, so only the columns and planes of the tile apply.
+            const TTL_CONST_EXT_TENSOR_TYPE gather_from = TTL_create_const_ext_tensor(
+                db->common.ext_tensor_in.base,
+                TTL_create_shape(
+                    next_tile.shape.width, db->common.ext_tensor_in.shape.height, next_tile.shape.depth),
+                db->common.ext_tensor_in.layout,
+                TTL_create_offset(next_tile.offset.x, 0, next_tile.offset.z),
+                db->common.ext_tensor_in.elem_size);
+
+            TTL_import_gather(import_to.tensor, gather_from, next_indices, db->event __TTL_TRACE_LINE);
+            *padding_cache = TTL_create_empty_padding_cache();
+        } else {
+            const bool reused = reuse_halo && TTL_import_sub_tensor_reusing(*TTL_to_void_sub_tensor(&import_to),
+                                                                             *TTL_to_void_tensor(&import_from),
+                                                                             *TTL_to_void_sub_tensor(&prev_imported),
+                                                                             db->conversion,
+                                                                             db->event,
+                                                                             padding_cache __TTL_TRACE_LINE);
+
+            if (reused == false) {
+                if (convert) {
+                    TTL_import_convert_sub_tensor_base(*TTL_to_void_sub_tensor(&import_to),
+                                                       *TTL_to_void_tensor(&import_from),
+                                                       db->conversion,
+                                                       db->event,
+                                                       padding_cache __TTL_TRACE_LINE);
+                } else {
+                    TTL_import_sub_tensor(import_to, import_from, db->event, padding_cache __TTL_TRACE_LINE);
+                }
+            }
+            TTL_prefetch_tile_after(*TTL_to_void_tensor(&db->common.ext_tensor_in), db->prev_tile, next_tile);
+        }
     }
 
     db->common.index = (db->common.index + 1) % 2;  // TTL_ARRAYSIZE(db->common.int_base);
 
-    const TTL_layout_t prev_int_layout = TTL_create_layout(db->prev_tile.shape.width, db->prev_tile.shape.height);
+    const TTL_layout_t prev_int_layout = TTL_create_packed_layout(db->prev_tile.shape);
     const TTL_INT_SUB_TENSOR_TYPE result = TTL_create_int_sub_tensor(db->common.int_base[db->common.index],
                                                                      db->prev_tile.shape,
                                                                      prev_int_layout,
-                                                                     db->common.ext_tensor_in,
+                                                                     int_elem_size,
+                                                                     TTL_create_offset(),
+                                                                     db->common.ext_tensor_in.shape,
                                                                      db->prev_tile.offset);
+    const TTL_CONST_EXT_TENSOR_TYPE result_from = TTL_create_const_ext_tensor(db->common.ext_tensor_in.base,
+                                                                              db->prev_tile.shape,
+                                                                              db->common.ext_tensor_in.layout,
+                                                                              db->prev_tile.offset,
+                                                                              db->common.ext_tensor_in.elem_size);
+    const bool prev_gathered = TTL_shape_empty(db->prev_indices.shape) == false;
 
     db->prev_tile = next_tile;
+    db->prev_indices = next_indices;
 
-    return result;
+    // A gathered or converted tile is always copied, so never refers to the external tensor.
+    return (prev_gathered || convert) ? result : TTL_imported_sub_tensor(result, result_from);
 }
 
 /**
  * @brief Wait for the previous import operation to complete before beginning an
- * export of next tile.
+ * import of the next tile.
  *
- * @param db A TTL_export_double_buffering_t describing the attributes of the
+ * @param db TTL_import_double_buffering_t describing the attributes of the
  * transfer
- * @param tile_current A description of the tile to begin exporting.
+ * @param next_tile A description of the tile to begin importing.
  *
  */
 static inline TTL_INT_SUB_TENSOR_TYPE __attribute__((overloadable))
-__TTL_TRACE_FN(TTL_step_buffering, TTL_EXPORT_DOUBLE_BUFFERING_TYPE *const db, TTL_tile_t tile_current) {
-    const TTL_layout_t int_layout = TTL_create_layout(db->prev_tile.shape.width, db->prev_tile.shape.height);
-    const TTL_CONST_INT_TENSOR_TYPE export_from = TTL_create_const_int_tensor(
-        db->common.int_base[db->common.index], db->prev_tile.shape, int_layout, db->common.ext_tensor_in.elem_size);
+__TTL_TRACE_FN(TTL_step_buffering, TTL_IMPORT_DOUBLE_BUFFERING_TYPE *const db, const TTL_tile_t next_tile) {
+    return __TTL_step_double_buffering(db, next_tile, TTL_create_empty_const_int_int_tensor() __TTL_TRACE_LINE);
+}
+
+/**
+ * @brief Wait for the previous import operation to complete before beginning a
+ * gather of the next tile.
+ *
+ * Line y of the next tile is imported from row next_indices[y] of the external tensor,
+ * the y offset of the tile is ignored. The indices are read before returning.
+ *
+ * @param db TTL_import_double_buffering_t describing the attributes of the
+ * transfer
+ * @param next_tile A description of the columns, planes and number of rows to gather.
+ * @param next_indices The external row for each line of the tile, @see TTL_import_gather
+ */
+static inline TTL_INT_SUB_TENSOR_TYPE __attribute__((overloadable))
+__TTL_TRACE_FN(TTL_step_buffering, TTL_IMPORT_DOUBLE_BUFFERING_TYPE *const db, const TTL_tile_t next_tile,
+               const TTL_const_int_int_tensor_t next_indices) {
+    return __TTL_step_double_buffering(db, next_tile, next_indices __TTL_TRACE_LINE);
+}
+
+/**
+ * @brief Create a TTL_import_double_buffering_t and begin gathering the first tile
+ *
+ * @see TTL_start_import_double_buffering and TTL_step_buffering
+ */
+static inline TTL_IMPORT_DOUBLE_BUFFERING_TYPE __attribute__((overloadable))
+__TTL_TRACE_FN(TTL_start_import_double_buffering, TTL_local(TTL_TENSOR_TYPE *) int_base1,
+               TTL_local(TTL_TENSOR_TYPE *) int_base2, TTL_CONST_EXT_TENSOR_TYPE ext_tensor, TTL_event_t *event,
+               TTL_tile_t first_tile, const TTL_const_int_int_tensor_t first_indices) {
+    TTL_IMPORT_DOUBLE_BUFFERING_TYPE result = TTL_start_import_double_buffering(
+        int_base1, int_base2, ext_tensor, event, TTL_create_empty_tile() __TTL_TRACE_LINE);
+
+    __TTL_step_double_buffering(&result, first_tile, first_indices __TTL_TRACE_LINE);
+
+    return result;
+}
+
+/**
+ * @brief Create a TTL_import_double_buffering_t that converts each element, and begin importing the first tile
+ *
+ * The external tensor may have a different element type to the internal buffers, it is held
+ * with the internal type but keeps its own element size. Converted tiles cannot be gathered.
+ *
+ * @param conversion The conversion, with src_type and dst_type set, @see TTL_import_convert_base
+ *
+ * @see TTL_start_import_double_buffering in TTL_converting_schemes.h
+ */
+static inline TTL_IMPORT_DOUBLE_BUFFERING_TYPE __attribute__((overloadable))
+__TTL_TRACE_FN(__TTL_start_import_double_buffering, TTL_local(TTL_TENSOR_TYPE *) int_base1,
+               TTL_local(TTL_TENSOR_TYPE *) int_base2, const TTL_const_ext_tensor_t ext_tensor, TTL_event_t *event,
+               TTL_tile_t first_tile, const TTL_conversion_t conversion) {
+    const TTL_CONST_EXT_TENSOR_TYPE held_ext_tensor =
+        TTL_create_const_ext_tensor((TTL_global(const TTL_TENSOR_TYPE *))ext_tensor.base,
+                                    ext_tensor.shape,
+                                    ext_tensor.layout,
+                                    TTL_create_offset(),
+                                    ext_tensor.elem_size);
+    TTL_IMPORT_DOUBLE_BUFFERING_TYPE result = TTL_start_import_double_buffering(
+        int_base1, int_base2, held_ext_tensor, event, TTL_create_empty_tile() __TTL_TRACE_LINE);
+
+    result.conversion = conversion;
+    TTL_step_buffering(&result, first_tile __TTL_TRACE_LINE);
+
+    return result;
+}
+
+/**
+ * @brief Implementation of the TTL_step_buffering for export double buffering
+ *
+ * The previous tile is scattered if indices were given with it, @see TTL_export_scatter
+ */
+static inline TTL_INT_SUB_TENSOR_TYPE __attribute__((overloadable))
+__TTL_TRACE_FN(__TTL_step_double_buffering, TTL_EXPORT_DOUBLE_BUFFERING_TYPE *const db, TTL_tile_t tile_current,
+               const TTL_const_int_int_tensor_t indices_current) {
+    const bool convert = TTL_conversion_empty(db->conversion) == false;
+    const TTL_dim_t int_elem_size =
+        convert ? TTL_element_size(db->conversion.src_type) : db->common.ext_tensor_in.elem_size;
+    const TTL_layout_t int_layout = TTL_create_packed_layout(db->prev_tile.shape);
+    const TTL_CONST_INT_SUB_TENSOR_TYPE export_from =
+        TTL_create_const_int_sub_tensor(db->common.int_base[db->common.index],
+                                        db->prev_tile.shape,
+                                        int_layout,
+                                        int_elem_size,
+                                        TTL_create_offset(),
+                                        db->common.ext_tensor_in.shape,
+                                        db->prev_tile.offset);
     const TTL_EXT_TENSOR_TYPE export_to = TTL_create_ext_tensor(db->common.ext_tensor_in.base,
                                                                 db->prev_tile.shape,
                                                                 db->common.ext_tensor_in.layout,
@@ -94,23 +241,125 @@ __TTL_TRACE_FN(TTL_step_buffering, TTL_EXPORT_DOUBLE_BUFFERING_TYPE *const db, T
 
     TTL_wait(1, db->event __TTL_TRACE_LINE);
 
-    if (TTL_tile_empty(db->prev_tile) == false)
-        TTL_export(*TTL_to_void_tensor(TTL_to_const_tensor(&export_from)),
-                   *TTL_to_void_tensor(&export_to),
-                   db->event __TTL_TRACE_LINE);
+    if (TTL_tile_empty(db->prev_tile) == false) {
+        if (TTL_shape_empty(db->prev_indices.shape) == false) {
+            // Rows go anywhere in the external tensor, so only the columns and planes of the tile apply.
+            const TTL_EXT_TENSOR_TYPE scatter_to = TTL_create_ext_tensor(
+                db->common.ext_tensor_in.base,
+                TTL_create_shape(
+                    db->prev_tile.shape.width, db->common.ext_tensor_in.shape.height, db->prev_tile.shape.depth),
+                db->common.ext_tensor_in.layout,
+                TTL_create_offset(db->prev_tile.offset.x, 0, db->prev_tile.offset.z),
+                db->common.ext_tensor_in.elem_size);
+
+            TTL_export_scatter(export_from.tensor, scatter_to, db->prev_indices, db->event __TTL_TRACE_LINE);
+        } else if (convert) {
+            TTL_export_convert_sub_tensor_base(*TTL_to_void_sub_tensor(&export_from),
+                                               *TTL_to_void_tensor(&export_to),
+                                               db->conversion,
+                                               db->event __TTL_TRACE_LINE);
+        } else {
+            // Only the part of an augmented tile inside the external tensor is written back.
+            TTL_export_sub_tensor(export_from, export_to, db->event __TTL_TRACE_LINE);
+        }
+    }
 
     db->common.index = (db->common.index + 1) % 2;  // TTL_ARRAYSIZE(db->common.int_base);
-    const TTL_layout_t curr_int_layout = TTL_create_layout(tile_current.shape.width, tile_current.shape.height);
+    const TTL_layout_t curr_int_layout = TTL_create_packed_layout(tile_current.shape);
     const TTL_INT_SUB_TENSOR_TYPE result = TTL_create_int_sub_tensor(db->common.int_base[db->common.index],
                                                                      tile_current.shape,
                                                                      curr_int_layout,
-                                                                     *TTL_to_const_tensor(&db->common.ext_tensor_in),
+                                                                     int_elem_size,
+                                                                     TTL_create_offset(),
+                                                                     db->common.ext_tensor_in.shape,
                                                                      tile_current.offset);
     db->prev_tile = tile_current;
+    db->prev_indices = indices_current;
+
+    return result;
+}
+
+/**
+ * @brief Wait for the previous import operation to complete before beginning an
+ * export of next tile.
+ *
+ * @param db A TTL_export_double_buffering_t describing the attributes of the
+ * transfer
+ * @param tile_current A description of the tile to begin exporting.
+ *
+ */
+static inline TTL_INT_SUB_TENSOR_TYPE __attribute__((overloadable))
+__TTL_TRACE_FN(TTL_step_buffering, TTL_EXPORT_DOUBLE_BUFFERING_TYPE *const db, TTL_tile_t tile_current) {
+    return __TTL_step_double_buffering(db, tile_current, TTL_create_empty_const_int_int_tensor() __TTL_TRACE_LINE);
+}
+
+/**
+ * @brief Wait for the previous export operation to complete before beginning a
+ * scatter of the previous tile.
+ *
+ * The tile returned is later exported with line y going to row indices_current[y] of
+ * the external tensor, the y offset of the tile is ignored. The indices are read at the
+ * next step, so must be unchanged until then.
+ *
+ * @param db A TTL_export_double_buffering_t describing the attributes of the
+ * transfer
+ * @param tile_current A description of the columns, planes and number of rows to scatter.
+ * @param indices_current The external row for each line of the tile, @see TTL_export_scatter
+ */
+static inline TTL_INT_SUB_TENSOR_TYPE __attribute__((overloadable))
+__TTL_TRACE_FN(TTL_step_buffering, TTL_EXPORT_DOUBLE_BUFFERING_TYPE *const db, TTL_tile_t tile_current,
+               const TTL_const_int_int_tensor_t indices_current) {
+    return __TTL_step_double_buffering(db, tile_current, indices_current __TTL_TRACE_LINE);
+}
+
+/**
+ * @brief Create a TTL_export_double_buffering_t that converts each element
+ *
+ * The external tensor may have a different element type to the internal buffers, it is held
+ * with the internal type but keeps its own element size. Converted tiles cannot be scattered.
+ *
+ * @param conversion The conversion, with src_type and dst_type set, @see TTL_export_convert_base
+ *
+ * @see TTL_start_export_double_buffering in TTL_converting_schemes.h
+ */
+static inline TTL_EXPORT_DOUBLE_BUFFERING_TYPE __attribute__((overloadable))
+__TTL_TRACE_FN(__TTL_start_export_double_buffering, TTL_local(TTL_TENSOR_TYPE *) int_base1,
+               TTL_local(TTL_TENSOR_TYPE *) int_base2, const TTL_ext_tensor_t ext_tensor, TTL_event_t *event,
+               const TTL_conversion_t conversion) {
+    const __TTL_tensor_name(TTL_, , ext_, TTL_TENSOR_TYPE, , _t) held_ext_tensor =
+        TTL_create_ext_tensor((TTL_global(TTL_TENSOR_TYPE *))ext_tensor.base,
+                              ext_tensor.shape,
+                              ext_tensor.layout,
+                              TTL_create_offset(),
+                              ext_tensor.elem_size);
+    TTL_EXPORT_DOUBLE_BUFFERING_TYPE result =
+        TTL_start_export_double_buffering(int_base1, int_base2, held_ext_tensor, event __TTL_TRACE_LINE);
+
+    result.conversion = conversion;
 
     return result;
 }
 
+/**
+ * @brief Import only the elements of each tile that the tile before it does not share
+ *
+ * Consecutive tiles of an overlap tiler share their overlap, which is then copied from the
+ * buffer of the previous tile rather than imported again from external memory, where it is
+ * a slab across the tile such as the columns shared with the tile to the left. Other tiles,
+ * and gathered tiles, are imported whole. @see TTL_import_sub_tensor_reusing
+ *
+ * The halo is copied from the buffer the kernel has just computed on, which presumes that the
+ * kernel only reads the imported tiles. A kernel that writes its results into its input tile in
+ * place would pass the modified elements to the next tile as its halo, without any error, so must
+ * not reuse halos, just as the padding cache presumes that nothing but the imports writes the
+ * padding of the buffers. @see TTL_import_pre_fill_cached
+ *
+ * @param db The TTL_import_double_buffering_t to reuse halos for, from its next step.
+ */
+static inline void __attribute__((overloadable)) TTL_reuse_halo(TTL_IMPORT_DOUBLE_BUFFERING_TYPE *const db) {
+    db->reuse_halo = true;
+}
+
 static inline void __attribute__((overloadable))
 __TTL_TRACE_FN(TTL_finish_buffering, TTL_IMPORT_DOUBLE_BUFFERING_TYPE *import_double_buffering) {
     (void)import_double_buffering;
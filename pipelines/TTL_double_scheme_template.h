@@ -103,6 +103,14 @@ typedef struct {
                            2) common;  ///< The information that is common to all pipeline schemes
     TTL_event_t *event;                ///< A pointer to the event that is used to track the progress of the transfer
     TTL_tile_t prev_tile;              ///< Store of the previous imported/exported tile */
+    /// The external rows of prev_tile if it was gathered or scattered, otherwise empty
+    TTL_const_int_int_tensor_t prev_indices;
+    /// Applied to each element as it is transferred, empty unless the internal and external types differ
+    TTL_conversion_t conversion;
+    /// The padding last written to each internal buffer, so that unchanged padding is not cleared again
+    TTL_padding_cache_t padding_cache[2];
+    /// Copy the elements each imported tile shares with the tile before it from that tile's buffer
+    bool reuse_halo;
 } TTL_DOUBLE_BUFFERING_TYPE;
 
 #ifdef TTL_IMPORT_DOUBLE
@@ -203,6 +211,11 @@ __TTL_TRACE_FN(TTL_IMPORT_EXPORT_NAME(TTL_start, double_buffering), TTL_local(TT
     result.common.index = 0;
 
     result.prev_tile = TTL_create_empty_tile();
+    result.prev_indices = TTL_create_empty_const_int_int_tensor();
+    result.conversion = TTL_create_empty_conversion();
+    result.padding_cache[0] = TTL_create_empty_padding_cache();
+    result.padding_cache[1] = TTL_create_empty_padding_cache();
+    result.reuse_halo = false;
 
 #ifdef TTL_IMPORT_DOUBLE
     TTL_step_buffering(&result, first_tile __TTL_TRACE_LINE);
@@ -63,7 +63,7 @@
  */
 #define TTL_DUPLEX_BUFFERING_TYPE __TTL_tensor_name(TTL_duplex_, const_, , TTL_TENSOR_TYPE, , _buffering_t)
 #define TTL_INT_SUB_TENSOR_TYPE __TTL_tensor_name(TTL_, , int_, TTL_TENSOR_TYPE, sub_, _t)
-#define TTL_CONST_INT_TENSOR_TYPE __TTL_tensor_name(TTL_, const_, int_, TTL_TENSOR_TYPE, , _t)
+#define TTL_CONST_INT_SUB_TENSOR_TYPE __TTL_tensor_name(TTL_, const_, int_, TTL_TENSOR_TYPE, sub_, _t)
 #define TTL_EXT_TENSOR_TYPE __TTL_tensor_name(TTL_, , ext_, TTL_TENSOR_TYPE, , _t)
 #define TTL_CONST_EXT_TENSOR_TYPE __TTL_tensor_name(TTL_, const_, ext_, TTL_TENSOR_TYPE, , _t)
 #define TTL_IO_TENSOR_TYPE __TTL_tensor_name(TTL_io_, , , TTL_TENSOR_TYPE, , _t)
@@ -88,7 +88,7 @@ typedef struct {
      */
     struct {
         TTL_EXT_TENSOR_TYPE to_export_to;
-        __TTL_tensor_name(TTL_, const_, int_, TTL_TENSOR_TYPE, , _t) to_export_from;
+        __TTL_tensor_name(TTL_, const_, int_, TTL_TENSOR_TYPE, sub_, _t) to_export_from;
     } prev_out_tensors;
 } TTL_DUPLEX_BUFFERING_TYPE;
 
@@ -195,7 +195,7 @@ __TTL_TRACE_FN(TTL_start_duplex_buffering, TTL_EXT_TENSOR_TYPE ext_tensor_in, TT
     result.common.ext_tensor_out = ext_tensor_out;
     result.events = events;
     result.prev_out_tensors.to_export_to = TTL_create_empty_ext_tensor((TTL_global(TTL_TENSOR_TYPE *))0);
-    result.prev_out_tensors.to_export_from = TTL_create_empty_const_int_tensor((TTL_local(TTL_TENSOR_TYPE *))0);
+    result.prev_out_tensors.to_export_from = TTL_create_empty_const_int_sub_tensor((TTL_local(TTL_TENSOR_TYPE *))0);
 
     TTL_step_buffering(&result, first_tile, TTL_create_empty_tile() __TTL_TRACE_LINE);
 
@@ -205,22 +205,22 @@ __TTL_TRACE_FN(TTL_start_duplex_buffering, TTL_EXT_TENSOR_TYPE ext_tensor_in, TT
 static inline TTL_IO_TENSOR_TYPE __attribute__((overloadable))
 __TTL_TRACE_FN(TTL_step_buffering, TTL_DUPLEX_BUFFERING_TYPE *const duplex_buffering, TTL_tile_t tile_current_import,
                TTL_tile_t tile_current_export) {
-    const TTL_layout_t next_import_layout =
-        TTL_create_layout(tile_current_import.shape.width, tile_current_import.shape.height);
+    const TTL_layout_t next_import_layout = TTL_create_packed_layout(tile_current_import.shape);
     const TTL_CONST_EXT_TENSOR_TYPE next_import_ext_tensor =
         TTL_create_const_ext_tensor(duplex_buffering->common.ext_tensor_in.base,
                                     tile_current_import.shape,
                                     duplex_buffering->common.ext_tensor_in.layout,
                                     tile_current_import.offset,
                                     duplex_buffering->common.ext_tensor_in.elem_size);
-    const TTL_INT_SUB_TENSOR_TYPE next_import_int_sub_tensor =
+    TTL_INT_SUB_TENSOR_TYPE next_import_int_sub_tensor =
         TTL_create_int_sub_tensor(duplex_buffering->common.int_base[0],
                                   tile_current_import.shape,
                                   next_import_layout,
                                   *TTL_to_const_tensor(&duplex_buffering->common.ext_tensor_in),
                                   tile_current_import.offset);
+    next_import_int_sub_tensor.origin.boundary = tile_current_import.boundary;
 
-    const TTL_CONST_INT_TENSOR_TYPE next_export_int_tensor = duplex_buffering->prev_out_tensors.to_export_from;
+    const TTL_CONST_INT_SUB_TENSOR_TYPE next_export_int_sub_tensor = duplex_buffering->prev_out_tensors.to_export_from;
     const TTL_EXT_TENSOR_TYPE next_export_ext_tensor = duplex_buffering->prev_out_tensors.to_export_to;
 
     if (TTL_tile_empty(tile_current_import) == false)
@@ -228,13 +228,12 @@ __TTL_TRACE_FN(TTL_step_buffering, TTL_DUPLEX_BUFFERING_TYPE *const duplex_buffe
                               *TTL_to_void_tensor(&next_import_ext_tensor),
                               &(*duplex_buffering->events)[0] __TTL_TRACE_LINE);
 
-    if (TTL_const_int_tensor_empty(duplex_buffering->prev_out_tensors.to_export_from) == false)
-        TTL_export(*TTL_to_void_tensor(&next_export_int_tensor),
-                   *TTL_to_void_tensor(&next_export_ext_tensor),
-                   &(*duplex_buffering->events)[1] __TTL_TRACE_LINE);
+    if (TTL_const_int_sub_tensor_empty(duplex_buffering->prev_out_tensors.to_export_from) == false)
+        TTL_export_sub_tensor(*TTL_to_void_sub_tensor(&next_export_int_sub_tensor),
+                              *TTL_to_void_tensor(&next_export_ext_tensor),
+                              &(*duplex_buffering->events)[1] __TTL_TRACE_LINE);
 
-    const TTL_layout_t int_export_layout =
-        TTL_create_layout(tile_current_export.shape.width, tile_current_export.shape.height);
+    const TTL_layout_t int_export_layout = TTL_create_packed_layout(tile_current_export.shape);
     const TTL_EXT_TENSOR_TYPE to_export_to = TTL_create_ext_tensor(duplex_buffering->common.ext_tensor_out.base,
                                                                    tile_current_export.shape,
                                                                    duplex_buffering->common.ext_tensor_out.layout,
@@ -244,15 +243,16 @@ __TTL_TRACE_FN(TTL_step_buffering, TTL_DUPLEX_BUFFERING_TYPE *const duplex_buffe
         TTL_create_int_sub_tensor(duplex_buffering->common.int_base[1],
                                   tile_current_export.shape,
                                   int_export_layout,
-                                  *TTL_to_const_tensor(&duplex_buffering->common.ext_tensor_in),
+                                  *TTL_to_const_tensor(&duplex_buffering->common.ext_tensor_out),
                                   tile_current_export.offset);
 
     duplex_buffering->prev_out_tensors.to_export_to = to_export_to;
-    duplex_buffering->prev_out_tensors.to_export_from = *TTL_to_const_tensor(&to_export_from.tensor);
+    duplex_buffering->prev_out_tensors.to_export_from = *TTL_to_const_sub_tensor(&to_export_from);
 
     TTL_wait(2, *duplex_buffering->events __TTL_TRACE_LINE);
 
-    return TTL_create_io_tensors(next_import_int_sub_tensor, to_export_from);
+    return TTL_create_io_tensors(TTL_imported_sub_tensor(next_import_int_sub_tensor, next_import_ext_tensor),
+                                 to_export_from);
 }
 
 static inline void __attribute__((overloadable))
@@ -162,14 +162,14 @@ __TTL_TRACE_FN(TTL_step_buffering, TTL_SIMPLEX_BUFFERING_TYPE *const simplex_buf
                TTL_tile_t tile_current_export) {
     // For performance, compute everything possible before waiting for the previous operations to finish. The current
     // index contains the tile that is to be exported, so prepare the structures before beginning the export and export.
-    const TTL_layout_t next_import_layout =
-        TTL_create_layout(tile_next_import.shape.width, tile_next_import.shape.height);
-    const TTL_INT_SUB_TENSOR_TYPE next_import_int_sub_tensor =
+    const TTL_layout_t next_import_layout = TTL_create_packed_layout(tile_next_import.shape);
+    TTL_INT_SUB_TENSOR_TYPE next_import_int_sub_tensor =
         TTL_create_int_sub_tensor(simplex_buffer->common.int_base[simplex_buffer->common.index],
                                   tile_next_import.shape,
                                   next_import_layout,
                                   *TTL_to_const_tensor(&simplex_buffer->common.ext_tensor_in),
                                   tile_next_import.offset);
+    next_import_int_sub_tensor.origin.boundary = tile_next_import.boundary;
     const TTL_CONST_EXT_TENSOR_TYPE next_import_ext_tensor =
         TTL_create_const_ext_tensor(simplex_buffer->common.ext_tensor_in.base,
                                     tile_next_import.shape,
@@ -177,13 +177,13 @@ __TTL_TRACE_FN(TTL_step_buffering, TTL_SIMPLEX_BUFFERING_TYPE *const simplex_buf
                                     tile_next_import.offset,
                                     simplex_buffer->common.ext_tensor_in.elem_size);
 
-    const TTL_layout_t int_export_layout = TTL_create_layout(simplex_buffer->next_exported_tile.shape.width,
-                                                             simplex_buffer->next_exported_tile.shape.height);
-    const TTL_INT_TENSOR_TYPE int_export_tensor =
-        TTL_create_int_tensor(simplex_buffer->common.int_base[simplex_buffer->common.index],
-                              simplex_buffer->next_exported_tile.shape,
-                              int_export_layout,
-                              simplex_buffer->common.ext_tensor_out.elem_size);
+    const TTL_layout_t int_export_layout = TTL_create_packed_layout(simplex_buffer->next_exported_tile.shape);
+    const TTL_INT_SUB_TENSOR_TYPE int_export_sub_tensor =
+        TTL_create_int_sub_tensor(simplex_buffer->common.int_base[simplex_buffer->common.index],
+                                  simplex_buffer->next_exported_tile.shape,
+                                  int_export_layout,
+                                  *TTL_to_const_tensor(&simplex_buffer->common.ext_tensor_out),
+                                  simplex_buffer->next_exported_tile.offset);
     const TTL_EXT_TENSOR_TYPE export_to = TTL_create_ext_tensor(simplex_buffer->common.ext_tensor_out.base,
                                                                 simplex_buffer->next_exported_tile.shape,
                                                                 simplex_buffer->common.ext_tensor_out.layout,
@@ -195,15 +195,28 @@ __TTL_TRACE_FN(TTL_step_buffering, TTL_SIMPLEX_BUFFERING_TYPE *const simplex_buf
     TTL_wait(1, simplex_buffer->event_in __TTL_TRACE_LINE);
 
     if (TTL_tile_empty(simplex_buffer->next_exported_tile) == false)
-        TTL_export(*TTL_to_const_tensor(TTL_to_void_tensor(&int_export_tensor)),
-                   *TTL_to_void_tensor(&export_to),
-                   simplex_buffer->event_out __TTL_TRACE_LINE);
+        TTL_export_sub_tensor(*TTL_to_void_sub_tensor(&int_export_sub_tensor),
+                              *TTL_to_void_tensor(&export_to),
+                              simplex_buffer->event_out __TTL_TRACE_LINE);
+
+    if (TTL_tile_empty(tile_next_import) == false) {
+        // The export above reads from the buffer being imported to, padding is written
+        // as the import is issued so the export must complete first.
+        if (TTL_import_pre_fill_required(*TTL_to_void_sub_tensor(&next_import_int_sub_tensor)))
+            TTL_wait(1, simplex_buffer->event_out __TTL_TRACE_LINE);
 
-    if (TTL_tile_empty(tile_next_import) == false)
         TTL_import_sub_tensor(*TTL_to_void_sub_tensor(&next_import_int_sub_tensor),
                               *TTL_to_void_tensor(TTL_to_const_tensor(&next_import_ext_tensor)),
                               simplex_buffer->event_in __TTL_TRACE_LINE);
 
+        const TTL_tile_t prev_import_tile = { simplex_buffer->int_prev_imported.tensor.shape,
+                                              simplex_buffer->int_prev_imported.origin.sub_offset,
+                                              simplex_buffer->int_prev_imported.origin.boundary };
+        TTL_prefetch_tile_after(*TTL_to_void_tensor(TTL_to_const_tensor(&simplex_buffer->common.ext_tensor_in)),
+                                prev_import_tile,
+                                tile_next_import);
+    }
+
     // The import/export has been started for the current tile, Move to the next
     // tile.
     simplex_buffer->common.index =
@@ -211,17 +224,16 @@ __TTL_TRACE_FN(TTL_step_buffering, TTL_SIMPLEX_BUFFERING_TYPE *const simplex_buf
 
     // Retrieve buffer imported previously to read from now.
     const TTL_INT_SUB_TENSOR_TYPE int_curr_buff_in = simplex_buffer->int_prev_imported;
-    simplex_buffer->int_prev_imported = next_import_int_sub_tensor;
+    simplex_buffer->int_prev_imported = TTL_imported_sub_tensor(next_import_int_sub_tensor, next_import_ext_tensor);
 
     // Can write to out buffer according to size of curr_tile, rather than size
     // recently exported.
-    const TTL_layout_t curr_int_layout =
-        TTL_create_layout(tile_current_export.shape.width, tile_current_export.shape.width);
+    const TTL_layout_t curr_int_layout = TTL_create_packed_layout(tile_current_export.shape);
     const TTL_INT_SUB_TENSOR_TYPE int_curr_buff_out =
         TTL_create_int_sub_tensor(simplex_buffer->common.int_base[simplex_buffer->common.index],
                                   tile_current_export.shape,
                                   curr_int_layout,
-                                  *TTL_to_const_tensor(&simplex_buffer->common.ext_tensor_in),
+                                  *TTL_to_const_tensor(&simplex_buffer->common.ext_tensor_out),
                                   tile_current_export.offset);
 
     // Save last two tiles to prevent common repeated get_tile()'s.
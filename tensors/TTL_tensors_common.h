@@ -103,6 +103,19 @@ static inline TTL_layout_t __attribute__((overloadable)) TTL_create_layout(__TTL
     return TTL_create_layout(0, 0);
 }
 
+/**
+ * @brief Create the layout of a tensor of shape whose rows and planes follow one another in memory
+ *
+ * @see TTL_layout_t for more information.
+ *
+ * @param shape The shape of the tensor
+ *
+ * @return A TTL_layout_t with no space between the rows or the planes of shape.
+ */
+static inline TTL_layout_t TTL_create_packed_layout(const TTL_shape_t shape) {
+    return TTL_create_layout(shape.width, shape.width * shape.height);
+}
+
 /**
  * @brief Calculate the absolute linear offset in elements, based on a given
  * tensor offset and layout
@@ -171,6 +184,7 @@ static inline TTL_offset_dim_t TTL_linearize(const TTL_offset_t offset, const TT
         struct {                                                                                             \
             TTL_shape_t shape;       /*!< The shape of the origin tensor in 3 dimensions */                  \
             TTL_offset_t sub_offset; /*!< The offset of the sub tensor from the origin sensor */             \
+            TTL_boundary_t boundary; /*!< The values of the origin tensor's elements outside of its shape */ \
         } origin;                                                                                            \
     } __TTL_tensor_name(TTL_, const_1, location, type, sub_, _t)
 
@@ -330,6 +344,7 @@ static inline TTL_offset_dim_t TTL_linearize(const TTL_offset_t offset, const TT
             base, shape, layout, offset, elem_size);                                                                  \
         result.origin.shape = origin_shape;                                                                           \
         result.origin.sub_offset = origin_offset;                                                                     \
+        result.origin.boundary = TTL_create_boundary();                                                               \
                                                                                                                       \
         return result;                                                                                                \
     }                                                                                                                 \
@@ -399,6 +414,7 @@ static inline TTL_offset_dim_t TTL_linearize(const TTL_offset_t offset, const TT
         result.tensor = __TTL_tensor_name(TTL_create_empty_, const_1, location, type, , )();                          \
         result.origin.shape = TTL_create_shape(0);                                                                    \
         result.origin.sub_offset = TTL_create_offset();                                                               \
+        result.origin.boundary = TTL_create_boundary();                                                               \
                                                                                                                       \
         return result;                                                                                                \
     }                                                                                                                 \
@@ -482,7 +498,7 @@ static inline TTL_offset_dim_t TTL_linearize(const TTL_offset_t offset, const TT
         __TTL_tensor_overloaded_name(TTL_create_, const_1, location, type, sub, )(                             \
             TTL_scope(const_2 type *) const base, const TTL_shape_t shape, const TTL_dim_t elem_size) {        \
         return __TTL_tensor_overloaded_name(TTL_create_, const_1, location, type, sub, )(                      \
-            base, shape, TTL_create_layout(shape.width, shape.height), TTL_create_offset(), elem_size);        \
+            base, shape, TTL_create_packed_layout(shape), TTL_create_offset(), elem_size);                     \
     }                                                                                                          \
     /**                                                                                                        \
      * @brief __TTL_tensor_overloaded_name(TTL_create_, const_1, location, type, sub, )                        \
@@ -501,7 +517,7 @@ static inline TTL_offset_dim_t TTL_linearize(const TTL_offset_t offset, const TT
         __TTL_tensor_overloaded_name(TTL_create_, const_1, location, type, sub, )(                             \
             TTL_scope(const_2 type *) const base, const TTL_shape_t shape) {                                   \
         return __TTL_tensor_overloaded_name(TTL_create_, const_1, location, type, sub, )(                      \
-            base, shape, TTL_create_layout(shape.width, shape.height), TTL_create_offset(), TTL_SIZEOF(type)); \
+            base, shape, TTL_create_packed_layout(shape), TTL_create_offset(), TTL_SIZEOF(type));              \
     }
 
 #define __TTL_create_create_sub_tensor_functions(TTL_scope, const_1, location, type, sub, const_2)                \